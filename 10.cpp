@@ -1,6 +1,20 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -68,11 +82,751 @@ vector<int> dijkstra(int start, int n, const vector<vector<Edge>> &graph)
     return dist; // Return the shortest distances from the start node to all other nodes
 }
 
-int main()
+// Number of sources handled together by dijkstraBatch (one int distance per lane)
+const int LANES = 8;
+
+// Relax the LANES distances of u into v over an edge of the given weight.
+// Returns the smallest lane value that improved, or INF if none did
+inline int relaxLanes(const int *du, int *dv, int weight)
+{
+#ifdef __AVX2__
+    __m256i candidate = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)du), _mm256_set1_epi32(weight));
+    __m256i current = _mm256_loadu_si256((const __m256i *)dv);
+    __m256i improved = _mm256_cmpgt_epi32(current, candidate);
+    if (_mm256_testz_si256(improved, improved))
+    {
+        return INF;
+    }
+    _mm256_storeu_si256((__m256i *)dv, _mm256_min_epi32(current, candidate));
+
+    // Horizontal minimum over the improved lanes only
+    __m256i keys = _mm256_blendv_epi8(_mm256_set1_epi32(INF), candidate, improved);
+    __m128i low = _mm_min_epi32(_mm256_castsi256_si128(keys), _mm256_extracti128_si256(keys, 1));
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(low);
+#else
+    // Branch-free form so the compiler can vectorise it
+    int best = INF;
+    for (int lane = 0; lane < LANES; ++lane)
+    {
+        int candidate = du[lane] + weight;
+        best = min(best, candidate < dv[lane] ? candidate : INF);
+        dv[lane] = min(dv[lane], candidate);
+    }
+    return best;
+#endif
+}
+
+// Vertices a bounded BFS around a seed source may visit while collecting its batch, and the
+// fewest sources a batch needs to beat one dijkstra() per source (a full 8-lane batch costs
+// about three scalar runs)
+const int GROUP_BUDGET = 1024;
+const int MIN_BATCH = LANES / 2;
+
+// Run one batch of up to LANES sources (laneSources[i] answers result[slots[i]]).
+// The lanes of one vertex are stored next to each other (dist[v * LANES + lane]), so one edge
+// relaxation updates all lanes with SIMD min/compare (AVX2 when compiled with -mavx2).
+// The lanes share a single heap keyed by the smallest lane that improved since the vertex was
+// last scanned (label-correcting), so a vertex is rescanned when far-apart lanes reach it at
+// different times
+void runBatch(const vector<int> &laneSources, const vector<int> &slots, int n, const vector<vector<Edge>> &graph,
+              vector<int> &dist, vector<int> &queuedKey, vector<vector<int>> &result)
+{
+    int count = laneSources.size();
+    fill(dist.begin(), dist.end(), INF);
+    fill(queuedKey.begin(), queuedKey.end(), INF);
+
+    priority_queue<pair<int, int>, vector<pair<int, int>>, Compare> pq;
+    for (int lane = 0; lane < count; ++lane)
+    {
+        int source = laneSources[lane];
+        dist[(size_t)source * LANES + lane] = 0;
+        if (queuedKey[source] == INF)
+        {
+            queuedKey[source] = 0;
+            pq.push({source, 0});
+        }
+    }
+
+    while (!pq.empty())
+    {
+        int node = pq.top().first;
+        int key = pq.top().second;
+        pq.pop();
+
+        // Skip entries superseded by a later, smaller key
+        if (key != queuedKey[node])
+        {
+            continue;
+        }
+        queuedKey[node] = INF;
+
+        const int *du = &dist[(size_t)node * LANES];
+        for (const Edge &edge : graph[node])
+        {
+            int neighbor = edge.destination;
+            int improved = relaxLanes(du, &dist[(size_t)neighbor * LANES], edge.weight);
+            if (improved < queuedKey[neighbor])
+            {
+                queuedKey[neighbor] = improved;
+                pq.push({neighbor, improved});
+            }
+        }
+    }
+
+    for (int lane = 0; lane < count; ++lane)
+    {
+        vector<int> &out = result[slots[lane]];
+        out.resize(n);
+        for (int v = 0; v < n; ++v)
+        {
+            out[v] = dist[(size_t)v * LANES + lane];
+        }
+    }
+}
+
+// Shortest distances from many sources at once (result[i] belongs to sources[i]).
+// Batches only pay off when their sources are close to each other, so sources are grouped by
+// locality first: a BFS of at most GROUP_BUDGET vertices around each not yet handled source
+// collects the nearest other pending sources. Groups of at least MIN_BATCH sources run as one
+// runBatch(); sources with too few neighbours run through plain dijkstra() instead, so
+// scattered sources cost the same as the sequential loop
+vector<vector<int>> dijkstraBatch(const vector<int> &sources, int n, const vector<vector<Edge>> &graph)
+{
+    int total = sources.size();
+    vector<vector<int>> result(total);
+    vector<int> dist((size_t)n * LANES);
+    vector<int> queuedKey(n); // key of the live heap entry of each vertex (INF = not queued)
+
+    // Pending sources as one linked list per vertex (several sources may share a vertex)
+    vector<int> pendingAt(n, -1), nextPending(total, -1);
+    for (int i = total - 1; i >= 0; --i)
+    {
+        nextPending[i] = pendingAt[sources[i]];
+        pendingAt[sources[i]] = i;
+    }
+
+    vector<int> seen(n, -1), frontier;
+    vector<int> laneSources, slots;
+    for (int seed = 0; seed < total; ++seed)
+    {
+        if (!result[seed].empty())
+        {
+            continue; // Already answered as part of an earlier group
+        }
+
+        // Bounded BFS from the seed; vertices are taken in hop order, so the batch gets the nearest sources
+        laneSources.clear();
+        slots.clear();
+        frontier.assign(1, sources[seed]);
+        seen[sources[seed]] = seed;
+        for (size_t head = 0; head < frontier.size() && (int)slots.size() < LANES; ++head)
+        {
+            int u = frontier[head];
+            while (pendingAt[u] != -1 && (int)slots.size() < LANES)
+            {
+                slots.push_back(pendingAt[u]);
+                laneSources.push_back(u);
+                pendingAt[u] = nextPending[pendingAt[u]];
+            }
+            for (const Edge &edge : graph[u])
+            {
+                if (seen[edge.destination] != seed && (int)frontier.size() < GROUP_BUDGET)
+                {
+                    seen[edge.destination] = seed;
+                    frontier.push_back(edge.destination);
+                }
+            }
+        }
+
+        if ((int)slots.size() >= MIN_BATCH)
+        {
+            runBatch(laneSources, slots, n, graph, dist, queuedKey, result);
+        }
+        else
+        {
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                result[slots[i]] = dijkstra(laneSources[i], n, graph);
+            }
+        }
+    }
+
+    return result;
+}
+
+// Compare dijkstraBatch with one dijkstra() call per source on a random-weight grid
+void benchmarkBatchDijkstra()
+{
+    int side = 300, n = side * side;
+    unsigned seed = 7;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    vector<vector<Edge>> graph(n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+            {
+                int w = 1 + nextRandom() % 100;
+                graph[u].push_back(Edge(u + 1, w));
+                graph[u + 1].push_back(Edge(u, w));
+            }
+            if (r + 1 < side)
+            {
+                int w = 1 + nextRandom() % 100;
+                graph[u].push_back(Edge(u + side, w));
+                graph[u + side].push_back(Edge(u, w));
+            }
+        }
+    }
+
+    // Random sources, a burst of sources from one 10x10 neighbourhood, and both interleaved
+    vector<int> randomSources(64), nearbySources(64), mixedSources(64);
+    int corner = nextRandom() % n;
+    for (int i = 0; i < 64; ++i)
+    {
+        randomSources[i] = nextRandom() % n;
+        int r = (corner / side + nextRandom() % 10) % side;
+        int c = (corner % side + nextRandom() % 10) % side;
+        nearbySources[i] = r * side + c;
+        mixedSources[i] = i % 2 ? randomSources[i] : nearbySources[i];
+    }
+
+    for (const vector<int> *sources : {&randomSources, &nearbySources, &mixedSources})
+    {
+        auto begin = chrono::steady_clock::now();
+        vector<vector<int>> sequential;
+        for (int source : *sources)
+        {
+            sequential.push_back(dijkstra(source, n, graph));
+        }
+        double sequentialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+        begin = chrono::steady_clock::now();
+        vector<vector<int>> batched = dijkstraBatch(*sources, n, graph);
+        double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+        const char *kind = sources == &randomSources ? " random" : sources == &nearbySources ? " nearby" : " mixed";
+        cout << sources->size() << kind << " sources on a " << side
+             << "x" << side << " grid: sequential " << sequentialMs << " ms, batched " << batchMs << " ms ("
+             << (batched == sequential ? "same distances" : "MISMATCH") << ")" << endl;
+    }
+}
+
+// Hub-labeling (2-hop) distance index built with pruned landmark labeling.
+// Every vertex v gets an out-label (hub, dist(v, hub)) and an in-label (hub, dist(hub, v));
+// dist(s, t) is the minimum of out(s)[h] + in(t)[h] over the hubs h the two labels share.
+// Hubs are numbered by rank (most central first) and each label is a sorted, contiguous
+// slice of one int array whose layout is also the file format, so a saved index can be mmap-ed
+class HubLabels
+{
+public:
+    HubLabels() {}
+    HubLabels(const HubLabels &) = delete;
+    HubLabels &operator=(const HubLabels &) = delete;
+
+    ~HubLabels()
+    {
+        unmap();
+    }
+
+    // Pruned landmark labeling: a forward and a backward Dijkstra from every vertex in rank
+    // order, each pruned wherever the labels built so far already give the distance
+    void build(int n, const vector<vector<Edge>> &graph)
+    {
+        unmap();
+        vector<vector<Edge>> reverseGraph(n);
+        for (int u = 0; u < n; ++u)
+        {
+            for (const Edge &edge : graph[u])
+            {
+                reverseGraph[edge.destination].push_back(Edge(u, edge.weight));
+            }
+        }
+
+        // Vertices that lie on many shortest paths make the best hubs. Estimate that by the
+        // subtree sizes in shortest-path trees from a few evenly spread roots (degree breaks ties)
+        vector<long long> coverage(n, 0);
+        vector<int> parent(n);
+        for (int sample = 0; sample < min(n, 16); ++sample)
+        {
+            int root = (long long)sample * n / min(n, 16);
+            vector<int> dist = dijkstra(root, n, graph);
+            vector<int> byDist;
+            for (int v = 0; v < n; ++v)
+            {
+                parent[v] = -1;
+                if (dist[v] != INF)
+                {
+                    byDist.push_back(v);
+                }
+            }
+            for (int u : byDist)
+            {
+                for (const Edge &edge : graph[u])
+                {
+                    if (parent[edge.destination] == -1 && edge.destination != root &&
+                        dist[u] + edge.weight == dist[edge.destination])
+                    {
+                        parent[edge.destination] = u;
+                    }
+                }
+            }
+            sort(byDist.begin(), byDist.end(), [&](int a, int b)
+                 { return dist[a] > dist[b]; });
+            vector<long long> subtree(n, 1);
+            for (int v : byDist)
+            {
+                coverage[v] += subtree[v];
+                if (parent[v] != -1)
+                {
+                    subtree[parent[v]] += subtree[v];
+                }
+            }
+        }
+
+        vector<int> order(n);
+        for (int v = 0; v < n; ++v)
+        {
+            order[v] = v;
+        }
+        sort(order.begin(), order.end(), [&](int a, int b)
+             {
+                 if (coverage[a] != coverage[b])
+                     return coverage[a] > coverage[b];
+                 size_t da = graph[a].size() + reverseGraph[a].size();
+                 size_t db = graph[b].size() + reverseGraph[b].size();
+                 return da != db ? da > db : a < b; });
+
+        vector<vector<pair<int, int>>> outLabel(n), inLabel(n); // (hub rank, distance)
+        vector<int> hubDist(n, INF);                            // label of the current hub by rank
+        vector<int> dist(n, INF);
+        vector<int> touched;
+
+        for (int rank = 0; rank < n; ++rank)
+        {
+            int hub = order[rank];
+            prunedSearch(hub, rank, graph, outLabel[hub], inLabel, hubDist, dist, touched);
+            prunedSearch(hub, rank, reverseGraph, inLabel[hub], outLabel, hubDist, dist, touched);
+        }
+
+        // Flatten into the file layout
+        size_t outCount = 0, inCount = 0;
+        for (int v = 0; v < n; ++v)
+        {
+            outCount += outLabel[v].size();
+            inCount += inLabel[v].size();
+        }
+        owned.assign(HEADER + 2 * (n + 1) + 2 * outCount + 2 * inCount, 0);
+        owned[0] = MAGIC;
+        owned[1] = n;
+        owned[2] = outCount;
+        owned[3] = inCount;
+        int *at = &owned[HEADER];
+        for (auto *labels : {&outLabel, &inLabel})
+        {
+            size_t total = labels == &outLabel ? outCount : inCount;
+            int *first = at, *hubs = at + n + 1, *dists = hubs + total;
+            first[0] = 0;
+            for (int v = 0; v < n; ++v)
+            {
+                first[v + 1] = first[v] + (*labels)[v].size();
+                for (size_t k = 0; k < (*labels)[v].size(); ++k)
+                {
+                    hubs[first[v] + k] = (*labels)[v][k].first;
+                    dists[first[v] + k] = (*labels)[v][k].second;
+                }
+            }
+            at = dists + total;
+        }
+        bind(owned.data());
+    }
+
+    // Shortest distance from s to t (INF if t is unreachable or either id is outside [0, n))
+    int query(int s, int t) const
+    {
+        if ((unsigned)s >= (unsigned)n || (unsigned)t >= (unsigned)n)
+        {
+            return INF;
+        }
+        return intersect(outHub + outFirst[s], outDist + outFirst[s], outFirst[s + 1] - outFirst[s],
+                         inHub + inFirst[t], inDist + inFirst[t], inFirst[t + 1] - inFirst[t]);
+    }
+
+    // Average number of entries in one out-label plus one in-label
+    double averageLabelSize() const
+    {
+        return n == 0 ? 0 : (double)(outFirst[n] + inFirst[n]) / n;
+    }
+
+    // Returns false if there is nothing to save yet (no build() or load()) or the write fails
+    bool save(const string &path) const
+    {
+        if (!base)
+        {
+            return false;
+        }
+        ofstream file(path, ios::binary);
+        file.write((const char *)base, fileInts() * sizeof(int));
+        return (bool)file;
+    }
+
+    // Map a saved index read-only (read into memory where mmap is not available)
+    bool load(const string &path)
+    {
+        unmap();
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)(HEADER * sizeof(int)) || info.st_size % sizeof(int) != 0)
+        {
+            close(fd);
+            return false;
+        }
+        void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+        mapped = data;
+        mappedSize = info.st_size;
+        const int *ints = (const int *)data;
+        size_t count = mappedSize / sizeof(int);
+#else
+        ifstream file(path, ios::binary | ios::ate);
+        long long bytes = file ? (long long)file.tellg() : -1;
+        int header[HEADER];
+        if (bytes < (long long)sizeof(header) || !file.seekg(0) || !file.read((char *)header, sizeof(header)) ||
+            header[1] < 0 || header[2] < 0 || header[3] < 0)
+        {
+            return false;
+        }
+        // Size the buffer only after the declared size matches the file
+        size_t declared = HEADER + 2 * ((size_t)header[1] + 1) + 2 * (size_t)header[2] + 2 * (size_t)header[3];
+        if ((unsigned long long)bytes != declared * sizeof(int))
+        {
+            return false;
+        }
+        owned.assign(header, header + HEADER);
+        owned.resize(declared);
+        if (!file.read((char *)&owned[HEADER], (owned.size() - HEADER) * sizeof(int)))
+        {
+            unmap();
+            return false;
+        }
+        const int *ints = owned.data();
+        size_t count = owned.size();
+#endif
+        if (!valid(ints, count))
+        {
+            unmap();
+            return false;
+        }
+        bind(ints);
+        return true;
+    }
+
+private:
+    static const int HEADER = 4;           // magic, n, out-label entries, in-label entries
+    static const int MAGIC = 0x4C425548;   // "HUBL"
+
+    int n = 0;
+    const int *base = nullptr;
+    const int *outFirst = nullptr, *outHub = nullptr, *outDist = nullptr;
+    const int *inFirst = nullptr, *inHub = nullptr, *inDist = nullptr;
+    vector<int> owned;        // storage after build()
+    void *mapped = nullptr;   // storage after load()
+    size_t mappedSize = 0;
+
+    size_t fileInts() const
+    {
+        return HEADER + 2 * (size_t)(n + 1) + 2 * (size_t)base[2] + 2 * (size_t)base[3];
+    }
+
+    // A file of `count` ints is only bound if its sizes add up exactly and every label slice lies
+    // inside its block (offsets start at 0, never decrease and end at the entry count)
+    static bool valid(const int *ints, size_t count)
+    {
+        if (count < HEADER || ints[0] != MAGIC || ints[1] < 0 || ints[2] < 0 || ints[3] < 0)
+        {
+            return false;
+        }
+        size_t n = ints[1];
+        if (count != HEADER + 2 * (n + 1) + 2 * (size_t)ints[2] + 2 * (size_t)ints[3])
+        {
+            return false;
+        }
+        const int *first = ints + HEADER;
+        for (int block = 0; block < 2; ++block)
+        {
+            int entries = ints[2 + block];
+            if (first[0] != 0 || first[n] != entries)
+            {
+                return false;
+            }
+            for (size_t v = 0; v < n; ++v)
+            {
+                if (first[v] > first[v + 1])
+                {
+                    return false;
+                }
+            }
+            first += n + 1 + 2 * (size_t)entries;
+        }
+        return true;
+    }
+
+    void bind(const int *data)
+    {
+        base = data;
+        n = data[1];
+        outFirst = data + HEADER;
+        outHub = outFirst + n + 1;
+        outDist = outHub + data[2];
+        inFirst = outDist + data[2];
+        inHub = inFirst + n + 1;
+        inDist = inHub + data[3];
+    }
+
+    void unmap()
+    {
+#ifndef _WIN32
+        if (mapped)
+        {
+            munmap(mapped, mappedSize);
+        }
+#endif
+        mapped = nullptr;
+        owned.clear();
+        base = nullptr;
+        n = 0;
+    }
+
+    // One pruned Dijkstra from hub over graph. The hub's own opposite label (ownLabel) is loaded
+    // into hubDist; a vertex u is pruned when ownLabel and labels[u] already give a distance <= d.
+    // Otherwise (rank, d) is appended to labels[u]
+    void prunedSearch(int hub, int rank, const vector<vector<Edge>> &graph, const vector<pair<int, int>> &ownLabel,
+                      vector<vector<pair<int, int>>> &labels, vector<int> &hubDist, vector<int> &dist,
+                      vector<int> &touched)
+    {
+        for (const auto &entry : ownLabel)
+        {
+            hubDist[entry.first] = entry.second;
+        }
+
+        priority_queue<pair<int, int>, vector<pair<int, int>>, Compare> pq;
+        dist[hub] = 0;
+        touched.push_back(hub);
+        pq.push({hub, 0});
+
+        while (!pq.empty())
+        {
+            int node = pq.top().first;
+            int node_dist = pq.top().second;
+            pq.pop();
+
+            if (node_dist > dist[node])
+            {
+                continue;
+            }
+
+            bool covered = false;
+            for (const auto &entry : labels[node])
+            {
+                if (hubDist[entry.first] != INF && hubDist[entry.first] + entry.second <= node_dist)
+                {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered)
+            {
+                continue;
+            }
+            labels[node].push_back({rank, node_dist});
+
+            for (const Edge &edge : graph[node])
+            {
+                int new_dist = node_dist + edge.weight;
+                if (new_dist < dist[edge.destination])
+                {
+                    if (dist[edge.destination] == INF)
+                    {
+                        touched.push_back(edge.destination);
+                    }
+                    dist[edge.destination] = new_dist;
+                    pq.push({edge.destination, new_dist});
+                }
+            }
+        }
+
+        for (int v : touched)
+        {
+            dist[v] = INF;
+        }
+        touched.clear();
+        for (const auto &entry : ownLabel)
+        {
+            hubDist[entry.first] = INF;
+        }
+    }
+
+    // Minimum da[i] + db[j] over matching hubs of two sorted lists
+    static int intersect(const int *a, const int *da, int na, const int *b, const int *db, int nb)
+    {
+        int best = INF;
+        int i = 0, j = 0;
+#ifdef __AVX2__
+        // Compare 8 hubs of a with 8 hubs of b (all 8 rotations of b), then move past the block
+        // with the smaller last hub; a match in either block is found before it is left behind
+        __m256i bestLanes = _mm256_set1_epi32(INF);
+        while (i + 8 <= na && j + 8 <= nb)
+        {
+            __m256i hubA = _mm256_loadu_si256((const __m256i *)(a + i));
+            __m256i distA = _mm256_loadu_si256((const __m256i *)(da + i));
+            __m256i hubB = _mm256_loadu_si256((const __m256i *)(b + j));
+            __m256i distB = _mm256_loadu_si256((const __m256i *)(db + j));
+            for (int r = 0; r < 8; ++r)
+            {
+                __m256i rotate = _mm256_add_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(r));
+                rotate = _mm256_and_si256(rotate, _mm256_set1_epi32(7));
+                __m256i match = _mm256_cmpeq_epi32(hubA, _mm256_permutevar8x32_epi32(hubB, rotate));
+                __m256i sum = _mm256_add_epi32(distA, _mm256_permutevar8x32_epi32(distB, rotate));
+                bestLanes = _mm256_min_epi32(bestLanes, _mm256_blendv_epi8(_mm256_set1_epi32(INF), sum, match));
+            }
+            int lastA = a[i + 7], lastB = b[j + 7];
+            i += lastA <= lastB ? 8 : 0;
+            j += lastB <= lastA ? 8 : 0;
+        }
+        __m128i low = _mm_min_epi32(_mm256_castsi256_si128(bestLanes), _mm256_extracti128_si256(bestLanes, 1));
+        low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+        low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+        best = _mm_cvtsi128_si32(low);
+
+        // Fewer than 8 hubs left in a: compare each of them with 8 hubs of b at a time
+        while (i < na && j + 8 <= nb)
+        {
+            if (b[j + 7] < a[i])
+            {
+                j += 8;
+                continue;
+            }
+            __m256i block = _mm256_loadu_si256((const __m256i *)(b + j));
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, _mm256_set1_epi32(a[i]))));
+            if (mask)
+            {
+                best = min(best, da[i] + db[j + __builtin_ctz(mask)]);
+            }
+            ++i;
+        }
+#endif
+        // Branch-free merge: which side advances is unpredictable, so compute it with compares
+        while (i < na && j < nb)
+        {
+            int x = a[i], y = b[j];
+            int sum = da[i] + db[j];
+            best = x == y && sum < best ? sum : best;
+            i += x <= y;
+            j += y <= x;
+        }
+        return best;
+    }
+};
+
+// Build a hub-label index for a grid, check it against Dijkstra and time queries
+void benchmarkHubLabels()
+{
+    int side = 100, n = side * side;
+    unsigned seed = 11;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    vector<vector<Edge>> graph(n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+            {
+                graph[u].push_back(Edge(u + 1, 1 + nextRandom() % 100));
+                graph[u + 1].push_back(Edge(u, 1 + nextRandom() % 100));
+            }
+            if (r + 1 < side)
+            {
+                graph[u].push_back(Edge(u + side, 1 + nextRandom() % 100));
+                graph[u + side].push_back(Edge(u, 1 + nextRandom() % 100));
+            }
+        }
+    }
+
+    auto begin = chrono::steady_clock::now();
+    HubLabels labels;
+    labels.build(n, graph);
+    double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    string path = "hub_labels.bin";
+    HubLabels mapped;
+    bool stored = labels.save(path) && mapped.load(path);
+
+    bool correct = stored;
+    for (int i = 0; i < 10 && correct; ++i)
+    {
+        int source = nextRandom() % n;
+        vector<int> dist = dijkstra(source, n, graph);
+        for (int t = 0; t < n; ++t)
+        {
+            correct = correct && mapped.query(source, t) == dist[t];
+        }
+    }
+
+    vector<pair<int, int>> queries(1000000);
+    for (auto &q : queries)
+    {
+        q = {nextRandom() % n, nextRandom() % n};
+    }
+    begin = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (auto &q : queries)
+    {
+        checksum += mapped.query(q.first, q.second);
+    }
+    double queryNs = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count() / queries.size();
+    remove(path.c_str());
+
+    cout << "Hub labels on a " << side << "x" << side << " grid: build " << buildMs << " ms, "
+         << labels.averageLabelSize() << " entries per vertex, " << queryNs << " ns per query ("
+         << (correct ? "matches Dijkstra" : "MISMATCH") << ", checksum " << checksum << ")" << endl;
+}
+
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        benchmarkBatchDijkstra();
+        benchmarkHubLabels();
+        return 0;
+    }
+
     // Example graph (undirected weighted graph)
     int n = 5; // Number of nodes
     vector<vector<Edge>> graph(n);
@@ -4,6 +4,11 @@
 #include <climits>
 #include <cmath>
 #include <algorithm>
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
 
 using namespace std;
 
@@ -54,55 +59,687 @@ vector<int> dijkstra(int start, int n, const vector<vector<Edge>> &graph)
     return dist;
 }
 
-// Function to calculate the shortest route using Dijkstra for multiple delivery points (Greedy approach)
-vector<int> findRoute(int start, const vector<vector<Edge>> &graph, const vector<int> &deliveryPoints)
+// Reusable Dijkstra state so that repeated searches do not reallocate O(n) arrays
+struct DijkstraScratch
+{
+    vector<int> dist;    // Tentative distances (INT_MAX = not reached yet)
+    vector<int> touched; // Nodes whose distance changed, reset after every search
+    vector<char> target; // 0 = not a target, 1 = pending target, 2 = settled target
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+
+    DijkstraScratch(int n) : dist(n, INT_MAX), target(n, 0) {}
+
+    // Fill row[j] with the distance from start to targets[j], stopping once every target is settled
+    void run(int start, const vector<vector<Edge>> &graph, const vector<int> &targets, vector<int> &row)
+    {
+        int pending = 0;
+        for (int t : targets)
+        {
+            if (target[t] == 0)
+            {
+                target[t] = 1;
+                pending++;
+            }
+        }
+
+        dist[start] = 0;
+        touched.push_back(start);
+        pq.push({0, start});
+
+        while (!pq.empty() && pending > 0)
+        {
+            int node = pq.top().second;
+            int node_dist = pq.top().first;
+            pq.pop();
+
+            if (node_dist > dist[node])
+            {
+                continue;
+            }
+
+            // The distance of a target is final as soon as it leaves the queue
+            if (target[node] == 1)
+            {
+                target[node] = 2;
+                pending--;
+            }
+
+            for (const Edge &edge : graph[node])
+            {
+                int neighbor = edge.destination;
+                int new_dist = node_dist + edge.weight;
+
+                if (new_dist < dist[neighbor])
+                {
+                    if (dist[neighbor] == INT_MAX)
+                    {
+                        touched.push_back(neighbor);
+                    }
+                    dist[neighbor] = new_dist;
+                    pq.push({new_dist, neighbor});
+                }
+            }
+        }
+
+        // Unsettled targets are unreachable and keep INT_MAX
+        for (size_t j = 0; j < targets.size(); ++j)
+        {
+            row[j] = target[targets[j]] == 2 ? dist[targets[j]] : INT_MAX;
+        }
+
+        // Reset only what this search touched
+        for (int node : touched)
+        {
+            dist[node] = INT_MAX;
+        }
+        for (int t : targets)
+        {
+            target[t] = 0;
+        }
+        touched.clear();
+        pq = decltype(pq)();
+    }
+};
+
+// Many-to-many distances: matrix[i][j] = shortest distance from sources[i] to targets[j].
+// Runs one truncated Dijkstra per source, with sources spread over numThreads threads (0 = all cores)
+vector<vector<int>> distanceMatrix(const vector<int> &sources, const vector<int> &targets,
+                                   const vector<vector<Edge>> &graph, int numThreads = 0)
 {
     int n = graph.size();
-    vector<int> totalDist(deliveryPoints.size());
-    vector<bool> visited(deliveryPoints.size(), false);
-    int currentPoint = start;
-    int totalDistance = 0;
+    int numSources = sources.size();
+    vector<vector<int>> matrix(numSources, vector<int>(targets.size(), INT_MAX));
 
-    vector<int> route;
-    route.push_back(currentPoint);
+    if (numThreads <= 0)
+    {
+        numThreads = max(1u, thread::hardware_concurrency());
+    }
+    numThreads = max(1, min(numThreads, numSources));
+
+    // Each worker owns its scratch space and writes disjoint rows of the matrix
+    auto worker = [&](int id)
+    {
+        DijkstraScratch scratch(n);
+        for (int i = id; i < numSources; i += numThreads)
+        {
+            scratch.run(sources[i], graph, targets, matrix[i]);
+        }
+    };
+
+    vector<thread> threads;
+    for (int t = 1; t < numThreads; ++t)
+    {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (thread &th : threads)
+    {
+        th.join();
+    }
 
-    for (int i = 0; i < deliveryPoints.size(); ++i)
+    return matrix;
+}
+
+// Local search (2-opt + Or-opt) that shortens an open tour over a square distance matrix.
+// order[0] is the fixed start; the other entries are matrix indices of the stops.
+// Moves are only tried towards the `neighbours` closest stops of each city, and a city whose
+// don't-look bit is set is skipped until one of its tour edges changes
+class RouteImprover
+{
+public:
+    RouteImprover(const vector<vector<int>> &dist, int neighbours = 8) : dist(dist)
     {
-        // Use Dijkstra to find the shortest path from currentPoint to each of the delivery points
-        vector<int> dist = dijkstra(currentPoint, n, graph);
+        int n = dist.size();
+        nearest.resize(n);
+        for (int a = 0; a < n; ++a)
+        {
+            for (int b = 0; b < n; ++b)
+            {
+                if (b != a && dist[a][b] != INT_MAX)
+                {
+                    nearest[a].push_back(b);
+                }
+            }
+            int keep = min<int>(neighbours, nearest[a].size());
+            partial_sort(nearest[a].begin(), nearest[a].begin() + keep, nearest[a].end(),
+                         [&](int x, int y)
+                         { return dist[a][x] < dist[a][y]; });
+            nearest[a].resize(keep);
+        }
+
+        incoming.resize(n);
+        for (int a = 0; a < n; ++a)
+        {
+            for (int b : nearest[a])
+            {
+                incoming[b].push_back(a);
+            }
+        }
+    }
+
+    // Improve order in place until no improving move is left or timeBudgetMs runs out
+    void improve(vector<int> &order, int timeBudgetMs)
+    {
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeBudgetMs);
+        int m = order.size();
+        if (m < 3)
+        {
+            return;
+        }
+
+        tour = order;
+        pos.assign(dist.size(), -1);
+        for (int i = 0; i < m; ++i)
+        {
+            pos[tour[i]] = i;
+        }
+        rebuildPrefix();
+
+        // Every city starts active (don't-look bit cleared)
+        vector<bool> dontLook(dist.size(), true);
+        queue<int> active;
+        for (int city : tour)
+        {
+            dontLook[city] = false;
+            active.push(city);
+        }
+
+        while (!active.empty() && chrono::steady_clock::now() < deadline)
+        {
+            int a = active.front();
+            active.pop();
+            if (dontLook[a])
+            {
+                continue;
+            }
+
+            vector<int> changed;
+            if (tryTwoOpt(a, changed) || tryOrOpt(a, changed))
+            {
+                // Wake up the endpoints of all edges touched by the move
+                for (int city : changed)
+                {
+                    if (dontLook[city])
+                    {
+                        dontLook[city] = false;
+                        active.push(city);
+                    }
+                }
+                if (!dontLook[a])
+                {
+                    active.push(a);
+                }
+            }
+            else
+            {
+                dontLook[a] = true;
+            }
+        }
+
+        order = tour;
+    }
+
+private:
+    const vector<vector<int>> &dist;
+    vector<vector<int>> nearest; // Candidate neighbours of each city, closest first
+    vector<vector<int>> incoming; // Cities that have a given city in their candidate list
+    vector<int> tour;            // Current tour (matrix indices)
+    vector<int> pos;             // Position of each city in the tour
+    vector<long long> fwd;       // fwd[p] = cost of tour[0..p] walked forwards
+    vector<long long> bwd;       // bwd[p] = cost of tour[0..p] walked backwards
+
+    long long cost(int a, int b)
+    {
+        return dist[a][b];
+    }
+
+    // Cost of the edge leaving position p (0 when p is the last stop of the open tour)
+    long long next(int p)
+    {
+        return p + 1 < (int)tour.size() ? cost(tour[p], tour[p + 1]) : 0;
+    }
+
+    void rebuildPrefix()
+    {
+        int m = tour.size();
+        fwd.assign(m, 0);
+        bwd.assign(m, 0);
+        for (int p = 1; p < m; ++p)
+        {
+            fwd[p] = fwd[p - 1] + cost(tour[p - 1], tour[p]);
+            bwd[p] = bwd[p - 1] + cost(tour[p], tour[p - 1]);
+        }
+    }
+
+    // Gain of reversing tour[i + 1 .. j]; the matrix may be asymmetric, so the reversed
+    // segment is re-priced from the backward prefix sums
+    long long twoOptGain(int i, int j)
+    {
+        long long before = cost(tour[i], tour[i + 1]) + next(j) + (fwd[j] - fwd[i + 1]);
+        long long after = cost(tour[i], tour[j]) + (bwd[j] - bwd[i + 1]);
+        if (j + 1 < (int)tour.size())
+        {
+            after += cost(tour[i + 1], tour[j + 1]);
+        }
+        return before - after;
+    }
+
+    void applyTwoOpt(int i, int j, vector<int> &changed)
+    {
+        changed = {tour[i], tour[i + 1], tour[j]};
+        if (j + 1 < (int)tour.size())
+        {
+            changed.push_back(tour[j + 1]);
+        }
+        reverse(tour.begin() + i + 1, tour.begin() + j + 1);
+        for (int p = i + 1; p <= j; ++p)
+        {
+            pos[tour[p]] = p;
+        }
+        rebuildPrefix();
+    }
+
+    // Try to add the edge a -> b (or b -> a) for one of a's candidate neighbours b
+    bool tryTwoOpt(int a, vector<int> &changed)
+    {
+        int i = pos[a];
+        for (int b : nearest[a])
+        {
+            int j = pos[b];
+            if (j < 0)
+            {
+                continue;
+            }
+            // a -> b becomes a tour edge by reversing tour[i + 1 .. j]
+            if (j > i + 1 && twoOptGain(i, j) > 0)
+            {
+                applyTwoOpt(i, j, changed);
+                return true;
+            }
+            // b -> a becomes a tour edge by reversing tour[j .. i - 1]
+            if (j >= 1 && j < i - 1 && twoOptGain(j - 1, i - 1) > 0)
+            {
+                applyTwoOpt(j - 1, i - 1, changed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Try to move a segment of 1..3 stops starting at a so that it follows a candidate neighbour
+    bool tryOrOpt(int a, vector<int> &changed)
+    {
+        int m = tour.size();
+        int s = pos[a];
+        if (s == 0)
+        {
+            return false; // The start location never moves
+        }
 
+        for (int len = 1; len <= 3 && s + len - 1 < m; ++len)
+        {
+            int e = s + len - 1;
+            int prev = tour[s - 1];
+            // The segment moves intact, so its inner edges cancel out of the gain
+            long long removeGain = cost(prev, a) + next(e);
+            long long bridge = 0;
+            if (e + 1 < m)
+            {
+                bridge = cost(prev, tour[e + 1]);
+            }
+
+            // Insert after b where a is one of b's candidate neighbours
+            for (int b : incoming[a])
+            {
+                int j = pos[b];
+                if (j < 0 || (j >= s - 1 && j <= e))
+                {
+                    continue;
+                }
+
+                long long insertCost = cost(b, a) - next(j);
+                if (j + 1 < m)
+                {
+                    insertCost += cost(tour[e], tour[j + 1]);
+                }
+
+                if (removeGain - bridge - insertCost > 0)
+                {
+                    changed = {prev, a, tour[e], b};
+                    if (e + 1 < m)
+                    {
+                        changed.push_back(tour[e + 1]);
+                    }
+                    if (j + 1 < m)
+                    {
+                        changed.push_back(tour[j + 1]);
+                    }
+
+                    // Move the segment right after position j
+                    if (j < s)
+                    {
+                        rotate(tour.begin() + j + 1, tour.begin() + s, tour.begin() + e + 1);
+                    }
+                    else
+                    {
+                        rotate(tour.begin() + s, tour.begin() + e + 1, tour.begin() + j + 1);
+                    }
+                    for (int p = 0; p < m; ++p)
+                    {
+                        pos[tour[p]] = p;
+                    }
+                    rebuildPrefix();
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+// Visiting order over a square start+stops distance matrix (index 0 = start).
+// The greedy nearest-neighbour tour is shortened with 2-opt / Or-opt when timeBudgetMs > 0
+vector<int> planStopOrder(const vector<vector<int>> &matrix, int timeBudgetMs)
+{
+    int k = matrix.size() - 1;
+    vector<bool> visited(k + 1, false);
+    vector<int> order;
+    order.push_back(0);
+    int current = 0;
+
+    for (int i = 0; i < k; ++i)
+    {
         // Find the nearest delivery point that has not been visited yet
         int minDist = INT_MAX;
         int nextPoint = -1;
 
-        for (int j = 0; j < deliveryPoints.size(); ++j)
+        for (int j = 1; j <= k; ++j)
         {
-            if (!visited[j])
+            if (!visited[j] && matrix[current][j] < minDist)
             {
-                if (dist[deliveryPoints[j]] < minDist)
-                {
-                    minDist = dist[deliveryPoints[j]];
-                    nextPoint = j;
-                }
+                minDist = matrix[current][j];
+                nextPoint = j;
             }
         }
 
-        // Mark the chosen point as visited and update total distance
+        // Remaining delivery points cannot be reached
+        if (nextPoint == -1)
+        {
+            break;
+        }
+
         visited[nextPoint] = true;
-        currentPoint = deliveryPoints[nextPoint];
-        totalDistance += minDist;
-        route.push_back(currentPoint);
+        current = nextPoint;
+        order.push_back(current);
+    }
+
+    if (timeBudgetMs > 0)
+    {
+        RouteImprover improver(matrix);
+        improver.improve(order, timeBudgetMs);
+    }
+    return order;
+}
+
+// Function to calculate the shortest route for multiple delivery points.
+// All start/stop distances come from a single distance matrix
+vector<int> findRoute(int start, const vector<vector<Edge>> &graph, const vector<int> &deliveryPoints,
+                      int timeBudgetMs = 0)
+{
+    // Index 0 is the start location, index j + 1 is delivery point j
+    vector<int> points;
+    points.push_back(start);
+    points.insert(points.end(), deliveryPoints.begin(), deliveryPoints.end());
+    vector<vector<int>> matrix = distanceMatrix(points, points, graph);
+    vector<int> order = planStopOrder(matrix, timeBudgetMs);
+
+    int totalDistance = 0;
+    vector<int> route;
+    route.push_back(start);
+    for (int i = 1; i < (int)order.size(); ++i)
+    {
+        totalDistance += matrix[order[i - 1]][order[i]];
+        route.push_back(points[order[i]]);
     }
 
     cout << "Total Distance: " << totalDistance << endl;
     return route;
 }
 
-int main()
+// One delivery job for the batch solver
+struct RouteJob
+{
+    int start;
+    vector<int> deliveryPoints;
+};
+
+// Result of one batch job, with the wall time it took on its worker
+struct RouteResult
+{
+    vector<int> route;
+    int totalDistance = 0;
+    double millis = 0;
+    int worker = -1;
+};
+
+// Batch route planner for many independent jobs over one shared read-only graph.
+// Jobs are dealt out in blocks to per-worker deques; a worker takes jobs from the back of its
+// own deque and, once empty, steals from the front of another worker's deque.
+// Every worker keeps its own Dijkstra scratch space, so no search allocates O(n) memory
+class BatchRouteSolver
+{
+public:
+    BatchRouteSolver(const vector<vector<Edge>> &graph, int numThreads = 0) : graph(graph)
+    {
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        this->numThreads = numThreads;
+    }
+
+    // Solve all jobs; results[i] belongs to jobs[i]
+    vector<RouteResult> solve(const vector<RouteJob> &jobs, int timeBudgetMs = 0)
+    {
+        int numJobs = jobs.size();
+        int workers = max(1, min(numThreads, numJobs));
+        vector<RouteResult> results(numJobs);
+        vector<WorkQueue> queues(workers);
+
+        for (int w = 0; w < workers; ++w)
+        {
+            int from = (long long)numJobs * w / workers;
+            int to = (long long)numJobs * (w + 1) / workers;
+            for (int i = from; i < to; ++i)
+            {
+                queues[w].jobs.push_back(i);
+            }
+        }
+
+        auto worker = [&](int id)
+        {
+            DijkstraScratch scratch(graph.size());
+            int job;
+            while (popLocal(queues, id, job) || steal(queues, id, job))
+            {
+                auto begin = chrono::steady_clock::now();
+                results[job] = runJob(jobs[job], scratch, timeBudgetMs);
+                results[job].millis = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+                results[job].worker = id;
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < workers; ++t)
+        {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+
+        return results;
+    }
+
+private:
+    struct WorkQueue
+    {
+        mutex lock;
+        deque<int> jobs;
+    };
+
+    const vector<vector<Edge>> &graph;
+    int numThreads;
+
+    bool popLocal(vector<WorkQueue> &queues, int id, int &job)
+    {
+        lock_guard<mutex> guard(queues[id].lock);
+        if (queues[id].jobs.empty())
+        {
+            return false;
+        }
+        job = queues[id].jobs.back();
+        queues[id].jobs.pop_back();
+        return true;
+    }
+
+    bool steal(vector<WorkQueue> &queues, int id, int &job)
+    {
+        int workers = queues.size();
+        for (int k = 1; k < workers; ++k)
+        {
+            WorkQueue &victim = queues[(id + k) % workers];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.jobs.empty())
+            {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Same planning as findRoute(), but single-threaded on the worker's scratch space
+    RouteResult runJob(const RouteJob &job, DijkstraScratch &scratch, int timeBudgetMs)
+    {
+        vector<int> points;
+        points.push_back(job.start);
+        points.insert(points.end(), job.deliveryPoints.begin(), job.deliveryPoints.end());
+
+        vector<vector<int>> matrix(points.size(), vector<int>(points.size(), INT_MAX));
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            scratch.run(points[i], graph, points, matrix[i]);
+        }
+        vector<int> order = planStopOrder(matrix, timeBudgetMs);
+
+        RouteResult result;
+        result.route.push_back(job.start);
+        for (int i = 1; i < (int)order.size(); ++i)
+        {
+            result.totalDistance += matrix[order[i - 1]][order[i]];
+            result.route.push_back(points[order[i]]);
+        }
+        return result;
+    }
+};
+
+// Throughput of the batch solver on a random grid city for 1, 2, 4, ... threads
+void benchmarkBatchRoutes()
+{
+    int side = 100, n = side * side;
+    vector<vector<Edge>> graph(n);
+    unsigned seed = 12345;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+            {
+                graph[u].push_back(Edge(u + 1, 1 + nextRandom() % 9));
+                graph[u + 1].push_back(Edge(u, 1 + nextRandom() % 9));
+            }
+            if (r + 1 < side)
+            {
+                graph[u].push_back(Edge(u + side, 1 + nextRandom() % 9));
+                graph[u + side].push_back(Edge(u, 1 + nextRandom() % 9));
+            }
+        }
+    }
+
+    vector<RouteJob> jobs(200);
+    for (RouteJob &job : jobs)
+    {
+        job.start = nextRandom() % n;
+        for (int i = 0; i < 10; ++i)
+        {
+            job.deliveryPoints.push_back(nextRandom() % n);
+        }
+    }
+
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    cout << "Batch routing: " << jobs.size() << " jobs x 10 stops on a " << side << "x" << side << " grid" << endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        BatchRouteSolver solver(graph, threads);
+        auto begin = chrono::steady_clock::now();
+        vector<RouteResult> results = solver.solve(jobs, 5);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+        double slowest = 0;
+        for (const RouteResult &result : results)
+        {
+            slowest = max(slowest, result.millis);
+        }
+        cout << "Threads: " << threads << "  Jobs/s: " << jobs.size() / seconds
+             << "  Slowest job: " << slowest << " ms" << endl;
+    }
+}
+
+// Known-answer check for RouteImprover: on this directed instance only moving the two-stop
+// segment 3 -> 4 (inner cost 20) to the front improves 0 1 2 3 4 (cost 50 -> 32)
+bool checkRouteImprover()
+{
+    vector<vector<int>> dist(5, vector<int>(5, 1000));
+    for (int i = 0; i < 5; ++i)
+    {
+        dist[i][i] = 0;
+    }
+    dist[0][1] = dist[1][2] = dist[2][3] = 10;
+    dist[3][4] = 20;
+    dist[0][3] = dist[4][1] = 1;
+    vector<int> order = {0, 1, 2, 3, 4};
+    RouteImprover improver(dist);
+    improver.improve(order, 1000);
+    bool ok = order == vector<int>({0, 3, 4, 1, 2});
+    cout << "Or-opt two-stop move: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        benchmarkBatchRoutes();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "check")
+    {
+        return checkRouteImprover() ? 0 : 1;
+    }
+
     // Example graph (adjacency list representation)
     int n = 6; // Total nodes (locations)
     vector<vector<Edge>> graph(n);
@@ -123,8 +760,8 @@ int main()
     // Start location
     int start = 0;
 
-    // Find the best route using a greedy approach
-    vector<int> route = findRoute(start, graph, deliveryPoints);
+    // Find the best route using a greedy approach, then improve it for up to 50 ms
+    vector<int> route = findRoute(start, graph, deliveryPoints, 50);
 
     // Output the delivery route
     cout << "Route: ";
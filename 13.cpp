@@ -2,22 +2,64 @@
 #include <vector>
 #include <queue>
 #include <climits>
+#include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
 
 using namespace std;
 
 const int INF = 1e9; // A large value to represent infinity (inaccessible paths)
 
+// Shortest-path tree kept up to date for a frequently queried source
+struct ShortestPathTree
+{
+    int source;
+    vector<int> dist;   // Distance from the source to every intersection
+    vector<int> parent; // Predecessor in the tree (-1 for the source and unreachable nodes)
+};
+
+const int DAY = 1440; // Length of the periodic travel-time profiles (minutes)
+
+// One point of a piecewise-linear travel-time function: leaving at `time` takes `travelTime`
+struct Breakpoint
+{
+    int time;
+    int travelTime;
+};
+
+// Location of one profile inside the shared breakpoint pool
+struct ProfileRef
+{
+    int offset;
+    int count;
+};
+
+// A route between two intersections
+struct Route
+{
+    vector<int> path; // Intersections from source to target
+    int length;       // Total travel time
+};
+
 // Graph structure to represent the city's road network
 class CityTrafficNetwork
 {
 public:
     vector<vector<pair<int, int>>> adjList; // adjacency list for roads (node, weight)
     int numIntersections;                   // number of intersections (nodes)
+    vector<ShortestPathTree> hotTrees;      // maintained trees for hot sources
+    vector<vector<int>> roadProfile;        // profile id per adjList entry (-1 = constant weight)
+    vector<Breakpoint> profilePool;         // breakpoints of all profiles, stored back to back
+    vector<ProfileRef> profiles;            // where each profile lives in profilePool
 
     CityTrafficNetwork(int n) : numIntersections(n)
     {
         adjList.resize(n);
+        roadProfile.resize(n);
+        inSubtree.assign(n, 0);
     }
 
     // Add a road (edge) between two intersections (nodes)
@@ -25,6 +67,198 @@ public:
     {
         adjList[u].push_back({v, weight});
         adjList[v].push_back({u, weight}); // Assuming bidirectional roads
+        roadProfile[u].push_back(-1);
+        roadProfile[v].push_back(-1);
+        for (ShortestPathTree &tree : hotTrees)
+        {
+            repairTree(tree, u, v, INF, weight);
+        }
+    }
+
+    // Change the travel time of the road between u and v (all parallel roads).
+    // Hot-source trees are repaired incrementally. Returns false if there is no such road
+    bool updateRoadWeight(int u, int v, int weight)
+    {
+        int oldWeight = INF;
+        for (auto &neighbor : adjList[u])
+        {
+            if (neighbor.first == v)
+            {
+                oldWeight = min(oldWeight, neighbor.second);
+                neighbor.second = weight;
+            }
+        }
+        if (oldWeight == INF)
+        {
+            return false;
+        }
+        for (auto &neighbor : adjList[v])
+        {
+            if (neighbor.first == u)
+            {
+                neighbor.second = weight;
+            }
+        }
+
+        for (ShortestPathTree &tree : hotTrees)
+        {
+            repairTree(tree, u, v, oldWeight, weight);
+        }
+        return true;
+    }
+
+    // Store a daily travel-time profile given as (departure minute, travel time) breakpoints with
+    // strictly increasing minutes in [0, DAY). Values between breakpoints are interpolated and the
+    // day wraps around. Returns the profile id, or -1 if the profile is not FIFO (leaving later
+    // must never mean arriving earlier, i.e. the slope is never below -1)
+    int addTravelTimeProfile(const vector<pair<int, int>> &breakpoints)
+    {
+        int count = breakpoints.size();
+        if (count == 0)
+        {
+            return -1;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            int t0 = breakpoints[i].first, f0 = breakpoints[i].second;
+            int t1 = i + 1 < count ? breakpoints[i + 1].first : breakpoints[0].first + DAY;
+            int f1 = i + 1 < count ? breakpoints[i + 1].second : breakpoints[0].second;
+            if (t0 < 0 || t0 >= DAY || f0 < 0 || t1 <= t0 || t0 + f0 > t1 + f1)
+            {
+                return -1;
+            }
+        }
+
+        profiles.push_back({(int)profilePool.size(), count});
+        for (const auto &bp : breakpoints)
+        {
+            profilePool.push_back({bp.first, bp.second});
+        }
+        return profiles.size() - 1;
+    }
+
+    // Let the road(s) between u and v follow a stored profile (-1 = back to constant weight).
+    // Returns false if there is no such road or no such profile
+    bool setRoadProfile(int u, int v, int profileId)
+    {
+        if (profileId < -1 || profileId >= (int)profiles.size())
+        {
+            return false;
+        }
+        bool found = false;
+        for (size_t i = 0; i < adjList[u].size(); ++i)
+        {
+            if (adjList[u][i].first == v)
+            {
+                roadProfile[u][i] = profileId;
+                found = true;
+            }
+        }
+        for (size_t i = 0; i < adjList[v].size(); ++i)
+        {
+            if (adjList[v][i].first == u)
+            {
+                roadProfile[v][i] = profileId;
+            }
+        }
+        return found;
+    }
+
+    // Travel time of a profile when leaving at minute `departure` (any day)
+    int evaluateProfile(int profileId, int departure)
+    {
+        const ProfileRef &ref = profiles[profileId];
+        const Breakpoint *bp = &profilePool[ref.offset];
+        int t = ((departure % DAY) + DAY) % DAY;
+
+        // First breakpoint strictly after t; its predecessor starts the current segment
+        int next = upper_bound(bp, bp + ref.count, t, [](int time, const Breakpoint &b)
+                               { return time < b.time; }) - bp;
+        int prev = next - 1;
+        double t0 = prev >= 0 ? bp[prev].time : bp[ref.count - 1].time - DAY;
+        double f0 = bp[(prev + ref.count) % ref.count].travelTime;
+        double t1 = next < ref.count ? bp[next].time : bp[0].time + DAY;
+        double f1 = bp[next % ref.count].travelTime;
+
+        return (int)floor(f0 + (f1 - f0) * (t - t0) / (t1 - t0));
+    }
+
+    // Earliest arrival time at every intersection when leaving source at minute `departure`.
+    // Label-setting Dijkstra is exact because every profile is FIFO
+    vector<int> timeDependentDijkstra(int source, int departure)
+    {
+        vector<int> arrival(numIntersections, INF);
+        arrival[source] = departure;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        pq.push({departure, source});
+
+        while (!pq.empty())
+        {
+            int u = pq.top().second;
+            int t = pq.top().first;
+            pq.pop();
+
+            if (t > arrival[u])
+                continue;
+
+            for (size_t i = 0; i < adjList[u].size(); ++i)
+            {
+                int v = adjList[u][i].first;
+                int profileId = roadProfile[u][i];
+                int weight = profileId == -1 ? adjList[u][i].second : evaluateProfile(profileId, t);
+
+                if (t + weight < arrival[v])
+                {
+                    arrival[v] = t + weight;
+                    pq.push({arrival[v], v});
+                }
+            }
+        }
+
+        return arrival;
+    }
+
+    // Keep a shortest-path tree for source up to date across road updates
+    void addHotSource(int source)
+    {
+        ShortestPathTree tree;
+        tree.source = source;
+        tree.dist.assign(numIntersections, INF);
+        tree.parent.assign(numIntersections, -1);
+        tree.dist[source] = 0;
+
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        pq.push({0, source});
+        propagate(tree, pq);
+        hotTrees.push_back(tree);
+    }
+
+    // Recompute every hot tree from scratch (after many weights changed at once)
+    void rebuildHotTrees()
+    {
+        for (ShortestPathTree &tree : hotTrees)
+        {
+            fill(tree.dist.begin(), tree.dist.end(), INF);
+            fill(tree.parent.begin(), tree.parent.end(), -1);
+            tree.dist[tree.source] = 0;
+
+            priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+            pq.push({0, tree.source});
+            propagate(tree, pq);
+        }
+    }
+
+    // Maintained tree for source, or nullptr if source is not hot
+    const ShortestPathTree *hotTree(int source) const
+    {
+        for (const ShortestPathTree &tree : hotTrees)
+        {
+            if (tree.source == source)
+            {
+                return &tree;
+            }
+        }
+        return nullptr;
     }
 
     // Dijkstra's algorithm to find the shortest paths from a source
@@ -60,62 +294,433 @@ public:
         return dist;
     }
 
-    // Find the centrality of nodes using betweenness centrality approximation
-    vector<int> betweennessCentrality()
+    // Repair a tree after the road u-v changed from oldWeight to newWeight (Ramalingam-Reps).
+    // A decrease is pushed outwards from the cheaper endpoint; an increase only recomputes
+    // the subtree hanging below the road, seeded from its unaffected neighbours
+    void repairTree(ShortestPathTree &tree, int u, int v, int oldWeight, int newWeight)
     {
-        vector<int> centrality(numIntersections, 0);
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        vector<int> &dist = tree.dist;
 
-        // Approximate betweenness centrality by considering all pairs of nodes
-        for (int i = 0; i < numIntersections; ++i)
+        if (newWeight < oldWeight)
+        {
+            int ends[2][2] = {{u, v}, {v, u}};
+            for (auto &end : ends)
+            {
+                int a = end[0], b = end[1];
+                if (dist[a] != INF && dist[a] + newWeight < dist[b])
+                {
+                    dist[b] = dist[a] + newWeight;
+                    tree.parent[b] = a;
+                    pq.push({dist[b], b});
+                }
+            }
+            propagate(tree, pq);
+            return;
+        }
+
+        int root = -1;
+        if (tree.parent[v] == u)
+        {
+            root = v;
+        }
+        else if (tree.parent[u] == v)
+        {
+            root = u;
+        }
+        if (root == -1 || newWeight == oldWeight)
         {
-            vector<int> dist = dijkstra(i); // Find shortest paths from node i
+            return; // The road is not a tree edge, so no distance changes
+        }
+
+        // Collect the subtree below the road: children of x are neighbours whose parent is x
+        vector<int> affected;
+        affected.push_back(root);
+        inSubtree[root] = 1;
+        for (size_t i = 0; i < affected.size(); ++i)
+        {
+            int x = affected[i];
+            for (auto &neighbor : adjList[x])
+            {
+                int y = neighbor.first;
+                if (!inSubtree[y] && tree.parent[y] == x)
+                {
+                    inSubtree[y] = 1;
+                    affected.push_back(y);
+                }
+            }
+        }
 
-            for (int j = 0; j < numIntersections; ++j)
+        for (int x : affected)
+        {
+            dist[x] = INF;
+            tree.parent[x] = -1;
+        }
+
+        // Best entry into every affected node from the unaffected part of the tree
+        for (int x : affected)
+        {
+            for (auto &neighbor : adjList[x])
             {
-                if (dist[j] != INF && i != j)
+                int y = neighbor.first;
+                if (!inSubtree[y] && dist[y] != INF && dist[y] + neighbor.second < dist[x])
                 {
-                    centrality[j] += 1; // Increment centrality if node j is in the path
+                    dist[x] = dist[y] + neighbor.second;
+                    tree.parent[x] = y;
                 }
             }
+            if (dist[x] != INF)
+            {
+                pq.push({dist[x], x});
+            }
+        }
+
+        for (int x : affected)
+        {
+            inSubtree[x] = 0;
+        }
+        propagate(tree, pq);
+    }
+
+    // Weighted betweenness centrality (Brandes): for every intersection, the number of shortest
+    // source-target routes passing through it, with ties split evenly. Sources are processed in
+    // parallel, each thread summing into its own accumulator. With samples > 0 only that many
+    // evenly spread sources are used and the result is scaled up to estimate the full value
+    vector<double> betweennessCentrality(int samples = 0, int numThreads = 0)
+    {
+        vector<int> sources;
+        if (samples <= 0 || samples >= numIntersections)
+        {
+            for (int i = 0; i < numIntersections; ++i)
+                sources.push_back(i);
+        }
+        else
+        {
+            for (int i = 0; i < samples; ++i)
+                sources.push_back((long long)i * numIntersections / samples);
+        }
+
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        numThreads = max(1, min<int>(numThreads, sources.size()));
+
+        vector<vector<double>> partial(numThreads, vector<double>(numIntersections, 0));
+        atomic<int> nextSource(0);
+        auto worker = [&](int id)
+        {
+            BrandesScratch scratch(numIntersections);
+            for (int i = nextSource++; i < (int)sources.size(); i = nextSource++)
+            {
+                accumulateDependencies(sources[i], scratch, partial[id]);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < numThreads; ++t)
+        {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+
+        // Roads are bidirectional, so every route was counted from both of its ends
+        double scale = 0.5 * numIntersections / sources.size();
+        vector<double> centrality(numIntersections, 0);
+        for (int t = 0; t < numThreads; ++t)
+        {
+            for (int i = 0; i < numIntersections; ++i)
+            {
+                centrality[i] += partial[t][i];
+            }
+        }
+        for (double &value : centrality)
+        {
+            value *= scale;
         }
 
         return centrality;
     }
 
-    // Find alternative routes by considering multiple shortest paths (using Dijkstra multiple times)
-    vector<vector<int>> findAlternativeRoutes(int source)
+    // The k shortest loopless routes from source to target in order (Yen's algorithm),
+    // limited to routes at most maxStretch times the shortest one
+    vector<Route> kShortestRoutes(int source, int target, int k, double maxStretch = 1e9)
     {
-        vector<vector<int>> allRoutes;
-        for (int i = 0; i < numIntersections; ++i)
+        vector<Route> found; // Yen's list of shortest paths in order
+
+        // One backward Dijkstra from the target gives an exact A* heuristic for every spur search
+        // and a ready-made spur path tree (follow toward[] hops) that is reused whenever it is not blocked
+        vector<int> toTarget, toward;
+        backwardTree(target, toTarget, toward);
+        if (toTarget[source] == INF || k <= 0)
+        {
+            return found;
+        }
+
+        found.push_back(treeRoute(source, toTarget, toward));
+        int limit = (int)min<double>(INF - 1, found[0].length * maxStretch);
+        vector<Route> candidates;     // Yen's candidate heap (small, scanned linearly)
+        vector<char> blocked(numIntersections, 0);
+        vector<int> spurDist(numIntersections, INF);
+        vector<int> spurParent(numIntersections, -1);
+
+        while ((int)found.size() < k)
+        {
+            const vector<int> last = found.back().path;
+            int rootLength = 0;
+
+            for (size_t i = 0; i + 1 < last.size(); ++i)
+            {
+                int spur = last[i];
+                if (i > 0)
+                {
+                    rootLength += roadWeight(last[i - 1], spur);
+                }
+                if (rootLength + toTarget[spur] > limit)
+                {
+                    break; // Every later spur node is at least as expensive
+                }
+
+                // Next hops already used by found paths with the same root
+                vector<int> blockedNext;
+                for (const Route &route : found)
+                {
+                    if (route.path.size() > i + 1 && equal(last.begin(), last.begin() + i + 1, route.path.begin()))
+                    {
+                        blockedNext.push_back(route.path[i + 1]);
+                    }
+                }
+                for (size_t j = 0; j < i; ++j)
+                {
+                    blocked[last[j]] = 1;
+                }
+
+                vector<int> spurPath;
+                int spurLength = spurSearch(spur, target, limit - rootLength, toTarget, toward, blocked,
+                                            blockedNext, spurDist, spurParent, spurPath);
+
+                for (size_t j = 0; j < i; ++j)
+                {
+                    blocked[last[j]] = 0;
+                }
+
+                if (spurLength == INF)
+                {
+                    continue;
+                }
+
+                Route candidate;
+                candidate.path.assign(last.begin(), last.begin() + i);
+                candidate.path.insert(candidate.path.end(), spurPath.begin(), spurPath.end());
+                candidate.length = rootLength + spurLength;
+
+                bool known = false;
+                for (const Route &route : candidates)
+                {
+                    known = known || route.path == candidate.path;
+                }
+                for (const Route &route : found)
+                {
+                    known = known || route.path == candidate.path;
+                }
+                if (!known)
+                {
+                    candidates.push_back(candidate);
+                }
+            }
+
+            if (candidates.empty())
+            {
+                break;
+            }
+
+            auto next = min_element(candidates.begin(), candidates.end(), [](const Route &a, const Route &b)
+                                    { return a.length < b.length; });
+            found.push_back(*next);
+            candidates.erase(next);
+        }
+
+        return found;
+    }
+
+    // Up to k diverse alternative routes from source to target, shortest first (penalty method).
+    // After each search the roads of the chosen route become more expensive, and the next search
+    // runs A* on the penalised weights. A route is only returned if it is at most maxStretch times
+    // the shortest route and shares at most maxOverlap of its travel time with every earlier route
+    vector<Route> findAlternativeRoutes(int source, int target, int k = 3, double maxStretch = 1.4,
+                                        double maxOverlap = 0.7, double penalty = 0.5)
+    {
+        vector<Route> accepted;
+        vector<int> toTarget, toward;
+        backwardTree(target, toTarget, toward);
+        if (toTarget[source] == INF || k <= 0)
+        {
+            return accepted;
+        }
+
+        accepted.push_back(treeRoute(source, toTarget, toward));
+        if (source == target)
+        {
+            return accepted; // The empty route is the only one
+        }
+        double limit = accepted[0].length * maxStretch;
+
+        // uses[u][i] = how many routes found so far drive along road adjList[u][i] (either way)
+        vector<vector<int>> uses(numIntersections);
+        for (int u = 0; u < numIntersections; ++u)
         {
-            if (i != source)
+            uses[u].assign(adjList[u].size(), 0);
+        }
+        vector<double> dist(numIntersections, 1e18);
+        vector<int> parent(numIntersections, -1);
+        Route last = accepted[0];
+
+        for (int round = 0; (int)accepted.size() < k && round < 4 * k; ++round)
+        {
+            for (size_t i = 0; i + 1 < last.path.size(); ++i)
+            {
+                int a = last.path[i], b = last.path[i + 1];
+                for (size_t j = 0; j < adjList[a].size(); ++j)
+                {
+                    uses[a][j] += adjList[a][j].first == b;
+                }
+                for (size_t j = 0; j < adjList[b].size(); ++j)
+                {
+                    uses[b][j] += adjList[b][j].first == a;
+                }
+            }
+
+            // A* on penalised weights; true distances to the target stay an admissible heuristic.
+            // Entries carry their g so stale ones are recognised exactly, without f - h rounding
+            vector<int> touched;
+            priority_queue<pair<double, pair<double, int>>, vector<pair<double, pair<double, int>>>,
+                           greater<pair<double, pair<double, int>>>>
+                pq; // (f, (g, intersection))
+            dist[source] = 0;
+            touched.push_back(source);
+            pq.push({(double)toTarget[source], {0.0, source}});
+
+            while (!pq.empty())
+            {
+                double g = pq.top().second.first;
+                int u = pq.top().second.second;
+                pq.pop();
+
+                if (g > dist[u])
+                    continue;
+                if (u == target)
+                    break;
+
+                for (size_t i = 0; i < adjList[u].size(); ++i)
+                {
+                    int v = adjList[u][i].first;
+                    if (toTarget[v] == INF)
+                        continue;
+                    double weight = adjList[u][i].second * (1 + penalty * uses[u][i]);
+                    if (dist[u] + weight < dist[v])
+                    {
+                        if (parent[v] == -1 && v != source)
+                        {
+                            touched.push_back(v);
+                        }
+                        dist[v] = dist[u] + weight;
+                        parent[v] = u;
+                        pq.push({dist[v] + toTarget[v], {dist[v], v}});
+                    }
+                }
+            }
+
+            if (parent[target] == -1)
+            {
+                for (int x : touched)
+                {
+                    dist[x] = 1e18;
+                    parent[x] = -1;
+                }
+                break; // Not reached; source != target here, so the target would have a parent
+            }
+
+            last.path.clear();
+            last.length = 0;
+            for (int x = target; x != source; x = parent[x])
+            {
+                last.path.push_back(x);
+                last.length += roadWeight(x, parent[x]);
+            }
+            last.path.push_back(source);
+            reverse(last.path.begin(), last.path.end());
+
+            for (int x : touched)
+            {
+                dist[x] = 1e18;
+                parent[x] = -1;
+            }
+
+            // Penalties only grow, so once the real length exceeds the bound it never comes back
+            if (last.length > limit)
+            {
+                break;
+            }
+
+            // A repeat of an accepted route is never an alternative, even when maxOverlap >= 1
+            bool diverse = true;
+            for (const Route &route : accepted)
             {
-                vector<int> dist = dijkstra(source);
-                allRoutes.push_back(dist);
+                diverse = diverse && route.path != last.path && sharedLength(last, route) <= maxOverlap * last.length;
+            }
+            if (diverse)
+            {
+                accepted.push_back(last);
             }
         }
-        return allRoutes;
+
+        sort(accepted.begin(), accepted.end(), [](const Route &a, const Route &b)
+             { return a.length < b.length; });
+        return accepted;
     }
 
     // Suggest optimal traffic light timings (based on traffic bottlenecks)
-    void suggestTrafficLightTimings()
+    // Intersections carrying more than twice the average shortest-route load are reported, busiest first.
+    // samples > 0 estimates the load from that many sources instead of all of them
+    void suggestTrafficLightTimings(int samples = 0)
     {
-        vector<int> centrality = betweennessCentrality();
+        vector<double> centrality = betweennessCentrality(samples);
 
-        cout << "Suggested Traffic Light Timings Based on Traffic Bottlenecks:" << endl;
+        double average = 0;
+        for (double value : centrality)
+        {
+            average += value / numIntersections;
+        }
+
+        vector<int> ranked(numIntersections);
         for (int i = 0; i < numIntersections; ++i)
         {
-            if (centrality[i] > 1)
-            { // Assuming a threshold for bottleneck detection
-                cout << "Intersection " << i << " is a potential bottleneck. Adjust traffic light timings." << endl;
+            ranked[i] = i;
+        }
+        sort(ranked.begin(), ranked.end(), [&](int a, int b)
+             { return centrality[a] > centrality[b]; });
+
+        cout << "Suggested Traffic Light Timings Based on Traffic Bottlenecks:" << endl;
+        for (int i : ranked)
+        {
+            if (centrality[i] <= 0 || centrality[i] <= 2 * average)
+            {
+                break;
             }
+            cout << "Intersection " << i << " is a potential bottleneck (load " << centrality[i]
+                 << "). Adjust traffic light timings." << endl;
         }
     }
 
     // Display the shortest path from source to all intersections
     void displayShortestPaths(int source)
     {
-        vector<int> dist = dijkstra(source);
+        const ShortestPathTree *tree = hotTree(source);
+        vector<int> dist = tree ? tree->dist : dijkstra(source);
 
         cout << "Shortest paths from Intersection " << source << " to all other intersections:" << endl;
         for (int i = 0; i < numIntersections; ++i)
@@ -130,17 +735,856 @@ public:
             }
         }
     }
-};
 
-int main()
-{
-    cout << "STT: 22520165\n";
-    cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
-    cout << "Homework-Lap5\n";
-    // Create a city with 6 intersections
-    CityTrafficNetwork city(6);
+private:
+    vector<char> inSubtree; // scratch marks for repairTree, all zero between calls
 
-    // Add roads between intersections with weights (representing traffic or travel time)
+    // Per-thread arrays for one Brandes single-source pass
+    struct BrandesScratch
+    {
+        vector<int> dist;
+        vector<double> sigma; // number of shortest routes from the source
+        vector<double> delta; // dependency of the source on each intersection
+        vector<int> order;    // intersections in the order they were settled
+
+        BrandesScratch(int n) : dist(n, INF), sigma(n, 0), delta(n, 0) {}
+    };
+
+    // Add the dependencies of one source to load (weighted Brandes single-source step)
+    void accumulateDependencies(int source, BrandesScratch &scratch, vector<double> &load)
+    {
+        vector<int> &dist = scratch.dist;
+        vector<double> &sigma = scratch.sigma;
+        vector<double> &delta = scratch.delta;
+        vector<int> &order = scratch.order;
+
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        dist[source] = 0;
+        sigma[source] = 1;
+        pq.push({0, source});
+
+        while (!pq.empty())
+        {
+            int u = pq.top().second;
+            int d = pq.top().first;
+            pq.pop();
+
+            if (d > dist[u])
+                continue;
+            order.push_back(u);
+
+            for (auto &neighbor : adjList[u])
+            {
+                int v = neighbor.first;
+                int nd = d + neighbor.second;
+                if (nd < dist[v])
+                {
+                    dist[v] = nd;
+                    sigma[v] = sigma[u];
+                    pq.push({nd, v});
+                }
+                else if (nd == dist[v])
+                {
+                    sigma[v] += sigma[u];
+                }
+            }
+        }
+
+        // Predecessors are found again from the distances instead of being stored
+        for (int i = order.size() - 1; i >= 0; --i)
+        {
+            int w = order[i];
+            for (auto &neighbor : adjList[w])
+            {
+                int v = neighbor.first;
+                if (dist[v] != INF && dist[v] + neighbor.second == dist[w])
+                {
+                    delta[v] += sigma[v] / sigma[w] * (1 + delta[w]);
+                }
+            }
+            if (w != source)
+            {
+                load[w] += delta[w];
+            }
+        }
+
+        for (int u : order)
+        {
+            dist[u] = INF;
+            sigma[u] = 0;
+            delta[u] = 0;
+        }
+        order.clear();
+    }
+
+    // Distances to target and the next hop towards it, from one Dijkstra rooted at target
+    void backwardTree(int target, vector<int> &toTarget, vector<int> &toward)
+    {
+        ShortestPathTree tree;
+        tree.source = target;
+        tree.dist.assign(numIntersections, INF);
+        tree.parent.assign(numIntersections, -1);
+        tree.dist[target] = 0;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        pq.push({0, target});
+        propagate(tree, pq);
+        toTarget.swap(tree.dist);
+        toward.swap(tree.parent);
+    }
+
+    // Shortest route from source by following the backward tree
+    Route treeRoute(int source, const vector<int> &toTarget, const vector<int> &toward)
+    {
+        Route route;
+        route.length = toTarget[source];
+        for (int x = source; x != -1; x = toward[x])
+        {
+            route.path.push_back(x);
+        }
+        return route;
+    }
+
+    // Travel time of the cheapest road between u and v
+    int roadWeight(int u, int v)
+    {
+        int weight = INF;
+        for (auto &neighbor : adjList[u])
+        {
+            if (neighbor.first == v)
+            {
+                weight = min(weight, neighbor.second);
+            }
+        }
+        return weight;
+    }
+
+    // Travel time on roads that both routes use
+    int sharedLength(const Route &a, const Route &b)
+    {
+        vector<long long> roads;
+        for (size_t i = 0; i + 1 < b.path.size(); ++i)
+        {
+            roads.push_back((long long)min(b.path[i], b.path[i + 1]) * numIntersections + max(b.path[i], b.path[i + 1]));
+        }
+        sort(roads.begin(), roads.end());
+
+        int shared = 0;
+        for (size_t i = 0; i + 1 < a.path.size(); ++i)
+        {
+            long long key = (long long)min(a.path[i], a.path[i + 1]) * numIntersections + max(a.path[i], a.path[i + 1]);
+            if (binary_search(roads.begin(), roads.end(), key))
+            {
+                shared += roadWeight(a.path[i], a.path[i + 1]);
+            }
+        }
+        return shared;
+    }
+
+    // Shortest spur path from spur to target avoiding blocked nodes and, on the first hop, the
+    // intersections in blockedNext. Returns its length (INF if none within bound) and fills path.
+    // dist/parent are all INF/-1 on entry and are reset before returning
+    int spurSearch(int spur, int target, int bound, const vector<int> &toTarget, const vector<int> &toward,
+                   const vector<char> &blocked, const vector<int> &blockedNext,
+                   vector<int> &dist, vector<int> &parent, vector<int> &path)
+    {
+        auto firstHopBlocked = [&](int v)
+        {
+            return find(blockedNext.begin(), blockedNext.end(), v) != blockedNext.end();
+        };
+
+        // Reuse the backward tree when its path from spur is still allowed
+        if (spur == target || !firstHopBlocked(toward[spur]))
+        {
+            bool clear = true;
+            for (int x = toward[spur]; x != -1 && clear; x = toward[x])
+            {
+                clear = !blocked[x];
+            }
+            if (clear)
+            {
+                for (int x = spur; x != -1; x = toward[x])
+                {
+                    path.push_back(x);
+                }
+                return toTarget[spur];
+            }
+        }
+
+        // A* with the exact backward distances as heuristic (removing roads only makes paths longer)
+        vector<int> touched;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
+        dist[spur] = 0;
+        touched.push_back(spur);
+        pq.push({toTarget[spur], spur});
+
+        while (!pq.empty())
+        {
+            int u = pq.top().second;
+            int f = pq.top().first;
+            pq.pop();
+
+            if (f - toTarget[u] > dist[u])
+                continue;
+            if (u == target || f > bound)
+                break;
+
+            for (auto &neighbor : adjList[u])
+            {
+                int v = neighbor.first;
+                if (blocked[v] || toTarget[v] == INF || (u == spur && firstHopBlocked(v)))
+                    continue;
+                if (dist[u] + neighbor.second < dist[v])
+                {
+                    if (dist[v] == INF)
+                    {
+                        touched.push_back(v);
+                    }
+                    dist[v] = dist[u] + neighbor.second;
+                    parent[v] = u;
+                    pq.push({dist[v] + toTarget[v], v});
+                }
+            }
+        }
+
+        int length = dist[target] <= bound ? dist[target] : INF;
+        if (length != INF)
+        {
+            for (int x = target; x != spur; x = parent[x])
+            {
+                path.push_back(x);
+            }
+            path.push_back(spur);
+            reverse(path.begin(), path.end());
+        }
+
+        for (int x : touched)
+        {
+            dist[x] = INF;
+            parent[x] = -1;
+        }
+        return length;
+    }
+
+    // Dijkstra relaxation from the queued nodes, recording parents in the tree
+    void propagate(ShortestPathTree &tree, priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> &pq)
+    {
+        while (!pq.empty())
+        {
+            int u = pq.top().second;
+            int d = pq.top().first;
+            pq.pop();
+
+            if (d > tree.dist[u])
+                continue;
+
+            for (auto &neighbor : adjList[u])
+            {
+                int v = neighbor.first;
+                if (d + neighbor.second < tree.dist[v])
+                {
+                    tree.dist[v] = d + neighbor.second;
+                    tree.parent[v] = u;
+                    pq.push({tree.dist[v], v});
+                }
+            }
+        }
+    }
+};
+
+// One origin-destination trip (demand in vehicles)
+struct Trip
+{
+    int origin;
+    int destination;
+    double demand;
+};
+
+// Measurements of one equilibrium round
+struct RoundStats
+{
+    int round;
+    double millis;          // wall time of the round
+    double relativeGap;     // (current travel time - shortest-route travel time) / current travel time
+    double totalTravelTime; // sum over roads of flow * travel time
+    double stepSize;        // Frank-Wolfe step taken in this round
+};
+
+// Static traffic assignment over a CityTrafficNetwork. Trips are routed on current travel times,
+// flows are accumulated per road direction, congestion follows the BPR function
+// t = t0 * (1 + alpha * (flow / capacity)^beta), and Frank-Wolfe rounds move the flows towards
+// user equilibrium. Trips are grouped by origin, so each round runs one Dijkstra per distinct
+// origin, spread over threads with per-thread flow accumulators
+class TrafficSimulation
+{
+public:
+    double alpha = 0.15;
+    double beta = 4;
+
+    TrafficSimulation(CityTrafficNetwork &city, double defaultCapacity, int numThreads = 0) : city(city)
+    {
+        int n = city.numIntersections;
+        firstRoad.assign(n + 1, 0);
+        for (int u = 0; u < n; ++u)
+        {
+            firstRoad[u + 1] = firstRoad[u] + city.adjList[u].size();
+        }
+        int roads = firstRoad[n];
+        roadSource.resize(roads);
+        roadTarget.resize(roads);
+        freeFlow.resize(roads);
+        capacity.assign(roads, defaultCapacity);
+        flow.assign(roads, 0);
+        for (int u = 0; u < n; ++u)
+        {
+            for (size_t i = 0; i < city.adjList[u].size(); ++i)
+            {
+                roadSource[firstRoad[u] + i] = u;
+                roadTarget[firstRoad[u] + i] = city.adjList[u][i].first;
+                freeFlow[firstRoad[u] + i] = city.adjList[u][i].second;
+            }
+        }
+
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        this->numThreads = numThreads;
+    }
+
+    // Capacity of both directions of the road(s) between u and v
+    void setCapacity(int u, int v, double roadCapacity)
+    {
+        for (int e = firstRoad[u]; e < firstRoad[u + 1]; ++e)
+            if (roadTarget[e] == v)
+                capacity[e] = roadCapacity;
+        for (int e = firstRoad[v]; e < firstRoad[v + 1]; ++e)
+            if (roadTarget[e] == u)
+                capacity[e] = roadCapacity;
+    }
+
+    // Run up to maxRounds Frank-Wolfe rounds or until the relative gap drops below targetGap,
+    // returning the statistics of each round. The congested travel times are written back into the city
+    vector<RoundStats> run(const vector<Trip> &trips, int maxRounds, double targetGap = 1e-4)
+    {
+        groupByOrigin(trips);
+        vector<RoundStats> stats;
+        vector<double> times = freeFlow;
+        vector<double> target;
+
+        // Round 0: everything on the free-flow shortest routes
+        allOrNothing(times, flow);
+
+        for (int round = 1; round <= maxRounds; ++round)
+        {
+            auto begin = chrono::steady_clock::now();
+            for (size_t e = 0; e < flow.size(); ++e)
+            {
+                times[e] = travelTime(e, flow[e]);
+            }
+            allOrNothing(times, target);
+
+            RoundStats round_stats;
+            round_stats.round = round;
+            round_stats.totalTravelTime = 0;
+            double shortest = 0;
+            for (size_t e = 0; e < flow.size(); ++e)
+            {
+                round_stats.totalTravelTime += flow[e] * times[e];
+                shortest += target[e] * times[e];
+            }
+            round_stats.relativeGap = round_stats.totalTravelTime > 0
+                                          ? (round_stats.totalTravelTime - shortest) / round_stats.totalTravelTime
+                                          : 0;
+
+            round_stats.stepSize = lineSearch(target);
+            for (size_t e = 0; e < flow.size(); ++e)
+            {
+                flow[e] += round_stats.stepSize * (target[e] - flow[e]);
+            }
+            round_stats.millis = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            stats.push_back(round_stats);
+
+            if (round_stats.relativeGap < targetGap)
+            {
+                break;
+            }
+        }
+
+        applyTravelTimes();
+        return stats;
+    }
+
+    // Current flow on the i-th road leaving u (in adjList order)
+    double roadFlow(int u, int i) const
+    {
+        return flow[firstRoad[u] + i];
+    }
+
+private:
+    CityTrafficNetwork &city;
+    int numThreads;
+    vector<int> firstRoad;     // roads leaving u are firstRoad[u] .. firstRoad[u + 1] - 1
+    vector<int> roadSource;    // tail intersection of each road direction
+    vector<int> roadTarget;    // head intersection of each road direction
+    vector<double> freeFlow;   // uncongested travel time
+    vector<double> capacity;   // vehicles per period before heavy congestion
+    vector<double> flow;       // current equilibrium flow
+    vector<int> origins;       // distinct origins
+    vector<int> firstTrip;     // trips of origins[k] are firstTrip[k] .. firstTrip[k + 1] - 1
+    vector<pair<int, double>> tripTargets; // (destination, demand) grouped by origin
+
+    double travelTime(int e, double roadFlow) const
+    {
+        return freeFlow[e] * (1 + alpha * pow(roadFlow / capacity[e], beta));
+    }
+
+    void groupByOrigin(const vector<Trip> &trips)
+    {
+        vector<int> order(trips.size());
+        for (size_t i = 0; i < trips.size(); ++i)
+        {
+            order[i] = i;
+        }
+        sort(order.begin(), order.end(), [&](int a, int b)
+             { return trips[a].origin < trips[b].origin; });
+
+        origins.clear();
+        firstTrip.clear();
+        tripTargets.clear();
+        for (int i : order)
+        {
+            if (origins.empty() || origins.back() != trips[i].origin)
+            {
+                origins.push_back(trips[i].origin);
+                firstTrip.push_back(tripTargets.size());
+            }
+            tripTargets.push_back({trips[i].destination, trips[i].demand});
+        }
+        firstTrip.push_back(tripTargets.size());
+    }
+
+    // Route every trip on its shortest route for the given travel times and sum the flows
+    void allOrNothing(const vector<double> &times, vector<double> &result)
+    {
+        int n = city.numIntersections;
+        int workers = max(1, min<int>(numThreads, origins.size()));
+        vector<vector<double>> partial(workers, vector<double>(times.size(), 0));
+        atomic<int> nextOrigin(0);
+
+        auto worker = [&](int id)
+        {
+            vector<double> dist(n, 1e18);
+            vector<int> parentRoad(n, -1);
+            vector<double> demand(n, 0);
+            vector<int> order;
+            priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+
+            for (int k = nextOrigin++; k < (int)origins.size(); k = nextOrigin++)
+            {
+                int origin = origins[k];
+                dist[origin] = 0;
+                pq.push({0, origin});
+                while (!pq.empty())
+                {
+                    int u = pq.top().second;
+                    double d = pq.top().first;
+                    pq.pop();
+                    if (d > dist[u])
+                        continue;
+                    order.push_back(u);
+                    for (int e = firstRoad[u]; e < firstRoad[u + 1]; ++e)
+                    {
+                        int v = roadTarget[e];
+                        if (d + times[e] < dist[v])
+                        {
+                            dist[v] = d + times[e];
+                            parentRoad[v] = e;
+                            pq.push({dist[v], v});
+                        }
+                    }
+                }
+
+                // Push demand from the leaves of the shortest-path tree back towards the origin
+                for (int t = firstTrip[k]; t < firstTrip[k + 1]; ++t)
+                {
+                    demand[tripTargets[t].first] += tripTargets[t].second;
+                }
+                for (int i = order.size() - 1; i > 0; --i)
+                {
+                    int v = order[i];
+                    if (demand[v] > 0)
+                    {
+                        int e = parentRoad[v];
+                        partial[id][e] += demand[v];
+                        demand[roadSource[e]] += demand[v];
+                    }
+                }
+
+                for (int u : order)
+                {
+                    dist[u] = 1e18;
+                    parentRoad[u] = -1;
+                    demand[u] = 0;
+                }
+                // Demand for destinations the origin cannot reach was never pushed back
+                for (int t = firstTrip[k]; t < firstTrip[k + 1]; ++t)
+                {
+                    demand[tripTargets[t].first] = 0;
+                }
+                order.clear();
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < workers; ++t)
+        {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+
+        result.assign(times.size(), 0);
+        for (const vector<double> &part : partial)
+        {
+            for (size_t e = 0; e < part.size(); ++e)
+            {
+                result[e] += part[e];
+            }
+        }
+    }
+
+    // Step in [0, 1] towards target that minimises the Beckmann objective (bisection on its slope)
+    double lineSearch(const vector<double> &target)
+    {
+        double low = 0, high = 1;
+        for (int iteration = 0; iteration < 30; ++iteration)
+        {
+            double mid = (low + high) / 2;
+            double slope = 0;
+            for (size_t e = 0; e < flow.size(); ++e)
+            {
+                double direction = target[e] - flow[e];
+                if (direction != 0)
+                {
+                    slope += direction * travelTime(e, flow[e] + mid * direction);
+                }
+            }
+            if (slope > 0)
+                high = mid;
+            else
+                low = mid;
+        }
+        return (low + high) / 2;
+    }
+
+    // Write the congested travel times back as road weights
+    void applyTravelTimes()
+    {
+        for (int u = 0; u < city.numIntersections; ++u)
+        {
+            for (size_t i = 0; i < city.adjList[u].size(); ++i)
+            {
+                int e = firstRoad[u] + i;
+                city.adjList[u][i].second = max(1, (int)lround(travelTime(e, flow[e])));
+            }
+        }
+        city.rebuildHotTrees();
+    }
+};
+
+// Route a million random trips over a grid city until user equilibrium
+vector<RoundStats> runTrafficSimulation()
+{
+    int side = 60, n = side * side;
+    unsigned seed = 31;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    CityTrafficNetwork city(n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+                city.addRoad(u, u + 1, 1 + nextRandom() % 5);
+            if (r + 1 < side)
+                city.addRoad(u, u + side, 1 + nextRandom() % 5);
+        }
+    }
+
+    // Trips start from 500 residential intersections
+    vector<Trip> trips(1000000);
+    for (Trip &trip : trips)
+    {
+        trip.origin = (nextRandom() % 500) * n / 500;
+        trip.destination = nextRandom() % n;
+        trip.demand = 1;
+    }
+
+    cout << "Traffic simulation: " << trips.size() << " trips on a " << side << "x" << side << " grid" << endl;
+    TrafficSimulation simulation(city, 20000);
+    return simulation.run(trips, 20, 1e-3);
+}
+
+// Compare incremental tree repair with full Dijkstra recomputation on a grid city
+void benchmarkIncrementalRepair()
+{
+    int side = 300, n = side * side;
+    unsigned seed = 2024;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    CityTrafficNetwork city(n);
+    vector<pair<int, int>> roads;
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+            {
+                city.addRoad(u, u + 1, 1 + nextRandom() % 20);
+                roads.push_back({u, u + 1});
+            }
+            if (r + 1 < side)
+            {
+                city.addRoad(u, u + side, 1 + nextRandom() % 20);
+                roads.push_back({u, u + side});
+            }
+        }
+    }
+
+    int hotSources[] = {0, n / 2, n - 1, side / 2};
+    for (int source : hotSources)
+    {
+        city.addHotSource(source);
+    }
+
+    cout << "Incremental repair on a " << side << "x" << side << " grid, 4 hot sources" << endl;
+    for (int batch : {1, 4, 16, 64})
+    {
+        double repairMs = 0, fullMs = 0;
+        bool consistent = true;
+        int rounds = 10;
+        for (int round = 0; round < rounds; ++round)
+        {
+            auto begin = chrono::steady_clock::now();
+            for (int i = 0; i < batch; ++i)
+            {
+                pair<int, int> road = roads[nextRandom() % roads.size()];
+                city.updateRoadWeight(road.first, road.second, 1 + nextRandom() % 20);
+            }
+            repairMs += chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+            begin = chrono::steady_clock::now();
+            for (int source : hotSources)
+            {
+                consistent = consistent && city.dijkstra(source) == city.hotTree(source)->dist;
+            }
+            fullMs += chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        }
+        cout << "Batch " << batch << ": repair " << repairMs / rounds << " ms, full recompute "
+             << fullMs / rounds << " ms" << (consistent ? "" : "  MISMATCH") << endl;
+    }
+}
+
+// Time alternative-route queries between random intersections of a grid city
+void benchmarkAlternativeRoutes()
+{
+    int side = 300, n = side * side;
+    unsigned seed = 77;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    CityTrafficNetwork city(n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+                city.addRoad(u, u + 1, 1 + nextRandom() % 20);
+            if (r + 1 < side)
+                city.addRoad(u, u + side, 1 + nextRandom() % 20);
+        }
+    }
+
+    int queries = 20, totalRoutes = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q)
+    {
+        totalRoutes += city.findAlternativeRoutes(nextRandom() % n, nextRandom() % n, 3).size();
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+    cout << "Alternative routes on a " << side << "x" << side << " grid: " << ms / queries
+         << " ms per query, " << (double)totalRoutes / queries << " routes on average" << endl;
+}
+
+// Exact versus sampled betweenness on a grid city
+void benchmarkBetweenness()
+{
+    int side = 60, n = side * side;
+    unsigned seed = 99;
+    auto nextRandom = [&]()
+    {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 8) & 0xFFFFFF);
+    };
+
+    CityTrafficNetwork city(n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            int u = r * side + c;
+            if (c + 1 < side)
+                city.addRoad(u, u + 1, 1 + nextRandom() % 20);
+            if (r + 1 < side)
+                city.addRoad(u, u + side, 1 + nextRandom() % 20);
+        }
+    }
+
+    auto begin = chrono::steady_clock::now();
+    vector<double> exact = city.betweennessCentrality();
+    double exactMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    begin = chrono::steady_clock::now();
+    vector<double> sampled = city.betweennessCentrality(200);
+    double sampledMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    // How many of the 50 busiest intersections the sample finds
+    vector<int> byExact(n), bySample(n);
+    for (int i = 0; i < n; ++i)
+    {
+        byExact[i] = bySample[i] = i;
+    }
+    sort(byExact.begin(), byExact.end(), [&](int a, int b)
+         { return exact[a] > exact[b]; });
+    sort(bySample.begin(), bySample.end(), [&](int a, int b)
+         { return sampled[a] > sampled[b]; });
+    int common = 0;
+    for (int i = 0; i < 50; ++i)
+    {
+        common += find(bySample.begin(), bySample.begin() + 50, byExact[i]) != bySample.begin() + 50;
+    }
+
+    cout << "Betweenness on a " << side << "x" << side << " grid: exact " << exactMs << " ms, 200 samples "
+         << sampledMs << " ms, top-50 overlap " << common << "/50" << endl;
+}
+
+// Known-answer check for kShortestRoutes (Yen) and findAlternativeRoutes on the example city,
+// which has exactly four loopless routes from 0 to 5: 0 1 3 5 (10), 0 1 2 4 5 (11),
+// 0 2 4 5 (12) and 0 2 1 3 5 (13)
+bool checkRoutes()
+{
+    CityTrafficNetwork city(6);
+    city.addRoad(0, 1, 2);
+    city.addRoad(0, 2, 4);
+    city.addRoad(1, 2, 1);
+    city.addRoad(1, 3, 7);
+    city.addRoad(2, 4, 3);
+    city.addRoad(3, 5, 1);
+    city.addRoad(4, 5, 5);
+
+    vector<vector<int>> expected = {{0, 1, 3, 5}, {0, 1, 2, 4, 5}, {0, 2, 4, 5}, {0, 2, 1, 3, 5}};
+    vector<int> lengths = {10, 11, 12, 13};
+    vector<Route> yen = city.kShortestRoutes(0, 5, 5);
+    bool yenOk = yen.size() == expected.size();
+    for (size_t i = 0; yenOk && i < yen.size(); ++i)
+    {
+        yenOk = yen[i].path == expected[i] && yen[i].length == lengths[i];
+    }
+    vector<Route> bounded = city.kShortestRoutes(0, 5, 5, 1.15);
+    yenOk = yenOk && bounded.size() == 2;
+    cout << "k shortest routes (Yen): " << (yenOk ? "ok" : "FAILED") << endl;
+
+    vector<Route> trivial = city.findAlternativeRoutes(2, 2, 3, 1.4, 1.0);
+    vector<Route> repeated = city.findAlternativeRoutes(0, 5, 3, 1.4, 1.0);
+    bool alternativesOk = trivial.size() == 1 && trivial[0].path == vector<int>({2}) && trivial[0].length == 0;
+    for (size_t i = 0; i < repeated.size(); ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        {
+            alternativesOk = alternativesOk && repeated[i].path != repeated[j].path;
+        }
+    }
+    cout << "Alternative routes without repeats: " << (alternativesOk ? "ok" : "FAILED") << endl;
+
+    // Chord 0 - 2 joins two intersections of the route 0 1 2 3 but is not on it, so it must not
+    // be penalised: the detour 0 2 3 (31) is found instead of the penalised original again
+    CityTrafficNetwork chord(4);
+    chord.addRoad(0, 1, 10);
+    chord.addRoad(1, 2, 10);
+    chord.addRoad(2, 3, 10);
+    chord.addRoad(0, 2, 21);
+    vector<Route> detour = chord.findAlternativeRoutes(0, 3, 2, 1.1, 1.0, 1.0);
+    bool chordOk = detour.size() == 2 && detour[1].path == vector<int>({0, 2, 3}) && detour[1].length == 31;
+    cout << "Penalties per road: " << (chordOk ? "ok" : "FAILED") << endl;
+    return yenOk && alternativesOk && chordOk;
+}
+
+// Profiles: unknown ids are refused, and a departure before midnight of day 0 wraps like any other day
+bool checkProfiles()
+{
+    CityTrafficNetwork city(2);
+    city.addRoad(0, 1, 10);
+    int profile = city.addTravelTimeProfile({{0, 10}, {DAY / 2, 30}});
+    bool ok = !city.setRoadProfile(0, 1, profile + 1) && !city.setRoadProfile(0, 1, -2) &&
+              city.setRoadProfile(0, 1, profile);
+    for (int departure : {-DAY / 4, -DAY - 1, DAY / 4, 2 * DAY + 1})
+    {
+        ok = ok && city.evaluateProfile(profile, departure) == city.evaluateProfile(profile, departure + 3 * DAY);
+    }
+    ok = ok && city.evaluateProfile(profile, -DAY / 2) == 30;
+    cout << "Travel-time profiles: " << (ok ? "ok" : "FAILED") << endl;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    cout << "STT: 22520165\n";
+    cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
+    cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        benchmarkIncrementalRepair();
+        benchmarkAlternativeRoutes();
+        benchmarkBetweenness();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "check")
+    {
+        bool ok = checkRoutes();
+        ok = checkProfiles() && ok;
+        return ok ? 0 : 1;
+    }
+    if (argc > 1 && string(argv[1]) == "simulate")
+    {
+        for (const RoundStats &round : runTrafficSimulation())
+        {
+            cout << "Round " << round.round << ": " << round.millis << " ms, relative gap " << round.relativeGap
+                 << ", total travel time " << round.totalTravelTime << ", step " << round.stepSize << endl;
+        }
+        return 0;
+    }
+
+    // Create a city with 6 intersections
+    CityTrafficNetwork city(6);
+
+    // Add roads between intersections with weights (representing traffic or travel time)
     city.addRoad(0, 1, 2); // Road between intersection 0 and 1 with a travel time of 2
     city.addRoad(0, 2, 4); // Road between intersection 0 and 2 with a travel time of 4
     city.addRoad(1, 2, 1); // Road between intersection 1 and 2 with a travel time of 1
@@ -155,12 +1599,32 @@ int main()
     // Suggest optimal traffic light timings based on traffic bottlenecks
     city.suggestTrafficLightTimings();
 
-    // Find alternative routes from intersection 0
-    vector<vector<int>> alternativeRoutes = city.findAlternativeRoutes(0);
-    cout << "Alternative Routes from Intersection 0:" << endl;
-    for (int i = 0; i < alternativeRoutes.size(); ++i)
+    // Rush hour: the road between 1 and 3 takes 7 minutes at night but 20 minutes at 08:00
+    vector<pair<int, int>> rushHour;
+    for (int minute = 0; minute < DAY; minute += 15) // 96 breakpoints per day
+    {
+        int fromPeak = abs(minute - 8 * 60);
+        rushHour.push_back({minute, fromPeak < 120 ? 20 - 13 * fromPeak / 120 : 7});
+    }
+    city.setRoadProfile(1, 3, city.addTravelTimeProfile(rushHour));
+    for (int departure : {3 * 60, 8 * 60})
+    {
+        vector<int> arrival = city.timeDependentDijkstra(0, departure);
+        cout << "Leaving intersection 0 at minute " << departure << ", arrival at intersection 5: "
+             << arrival[5] << " (travel time " << arrival[5] - departure << ")" << endl;
+    }
+
+    // Find alternative routes from intersection 0 to intersection 5
+    vector<Route> alternativeRoutes = city.findAlternativeRoutes(0, 5, 3, 1.5);
+    cout << "Alternative Routes from Intersection 0 to Intersection 5:" << endl;
+    for (const Route &route : alternativeRoutes)
     {
-        cout << "Distance to Intersection " << i << ": " << alternativeRoutes[i][i] << endl;
+        cout << "Travel time " << route.length << ": ";
+        for (int intersection : route.path)
+        {
+            cout << intersection << " ";
+        }
+        cout << endl;
     }
     system("pause");
     return 0;
@@ -2,6 +2,13 @@
 #include <vector>
 #include <algorithm>
 #include <climits>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <queue>
 
 using namespace std;
 
@@ -12,12 +19,21 @@ struct Edge
     Edge(int u, int v, int weight) : u(u), v(v), weight(weight) {}
 };
 
+// Indexed (CSR) adjacency built from an edge list: the arcs of u are first[u] .. first[u + 1] - 1,
+// every undirected edge appears once from each end, and edgeId points back into the edge list
+struct AdjacencyView
+{
+    vector<int> first;
+    vector<int> target;
+    vector<int> edgeId;
+};
+
 // Class to represent the graph
 class Graph
 {
 public:
     int V;              // Number of vertices (devices)
-    vector<Edge> edges; // List of edges (connections)
+    vector<Edge> edges; // List of edges (connections); call invalidateAdjacency() after changing it directly
 
     Graph(int V)
     {
@@ -28,6 +44,43 @@ public:
     void addEdge(int u, int v, int weight)
     {
         edges.push_back(Edge(u, v, weight));
+        invalidateAdjacency();
+    }
+
+    // Drop the cached adjacency view; it is rebuilt on the next traversal
+    void invalidateAdjacency()
+    {
+        adjacencyValid = false;
+    }
+
+    // Adjacency view of the current edge list, built on demand and cached
+    const AdjacencyView &adjacency()
+    {
+        if (!adjacencyValid)
+        {
+            view.first.assign(V + 1, 0);
+            view.target.resize(2 * edges.size());
+            view.edgeId.resize(2 * edges.size());
+            for (const auto &edge : edges)
+            {
+                view.first[edge.u + 1]++;
+                view.first[edge.v + 1]++;
+            }
+            for (int i = 0; i < V; i++)
+            {
+                view.first[i + 1] += view.first[i];
+            }
+            vector<int> slot(view.first.begin(), view.first.end() - 1);
+            for (int id = 0; id < (int)edges.size(); id++)
+            {
+                view.target[slot[edges[id].u]] = edges[id].v;
+                view.edgeId[slot[edges[id].u]++] = id;
+                view.target[slot[edges[id].v]] = edges[id].u;
+                view.edgeId[slot[edges[id].v]++] = id;
+            }
+            adjacencyValid = true;
+        }
+        return view;
     }
 
     // Find the parent of a node using Union-Find
@@ -70,6 +123,7 @@ public:
     {
         sort(edges.begin(), edges.end(), [](const Edge &e1, const Edge &e2)
              { return e1.weight < e2.weight; });
+        invalidateAdjacency(); // edge ids changed
 
         vector<int> parent(V);
         vector<int> rank(V, 0);
@@ -91,60 +145,1002 @@ public:
         return mst;
     }
 
-    // Helper function to find bridges (critical edges) in the graph
-    void dfs(int u, vector<bool> &visited, vector<int> &disc, vector<int> &low,
-             vector<int> &parent, vector<Edge> &bridges)
+    // Filter-Kruskal: partition the edges around a pivot weight, solve the light part first, then
+    // drop heavy edges that already close a cycle before recursing on them. Heavy edges that get
+    // filtered out are never sorted. The edge list itself is left untouched
+    vector<Edge> filterKruskalMST()
+    {
+        vector<Edge> work = edges;
+        vector<int> parent(V), rank(V, 0);
+        for (int i = 0; i < V; i++)
+        {
+            parent[i] = i;
+        }
+        vector<Edge> mst;
+        filterKruskal(work, 0, work.size(), parent, rank, mst);
+        return mst;
+    }
+
+    // Parallel Boruvka: every round each component picks its cheapest outgoing edge (atomic min
+    // over (weight, edge id), so ties are broken consistently and the picks form a forest), the
+    // picked edges are contracted with a lock-free union-find, and edges inside one component
+    // are dropped before the next round
+    vector<Edge> boruvkaMST(int numThreads = 0)
+    {
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        vector<atomic<int>> link(V);
+        vector<atomic<uint64_t>> cheapest(V);
+        for (int i = 0; i < V; i++)
+        {
+            link[i].store(i, memory_order_relaxed);
+            cheapest[i].store(UINT64_MAX, memory_order_relaxed);
+        }
+
+        vector<int> active(edges.size());
+        for (int id = 0; id < (int)edges.size(); id++)
+        {
+            active[id] = id;
+        }
+        vector<vector<Edge>> picked(numThreads);
+        vector<vector<int>> kept(numThreads);
+
+        while (!active.empty())
+        {
+            // Cheapest edge leaving each component; edges inside a component are dropped
+            parallelChunks(active.size(), numThreads, [&](int t, size_t from, size_t to)
+                           {
+                               kept[t].clear();
+                               for (size_t i = from; i < to; i++)
+                               {
+                                   const Edge &edge = edges[active[i]];
+                                   int ru = findRoot(link, edge.u), rv = findRoot(link, edge.v);
+                                   if (ru == rv)
+                                       continue;
+                                   kept[t].push_back(active[i]);
+                                   uint64_t key = ((uint64_t)((int64_t)edge.weight - INT_MIN) << 32) | (uint32_t)active[i];
+                                   atomicMin(cheapest[ru], key);
+                                   atomicMin(cheapest[rv], key);
+                               } });
+
+            // Clear every part here: a later round with fewer edges may run fewer workers, and
+            // an idle worker would leave its old part behind
+            active.clear();
+            for (auto &part : kept)
+            {
+                active.insert(active.end(), part.begin(), part.end());
+                part.clear();
+            }
+            if (active.empty())
+            {
+                break;
+            }
+
+            // Contract the picked edges; an edge picked from both sides is added once
+            parallelChunks(V, numThreads, [&](int t, size_t from, size_t to)
+                           {
+                               for (size_t v = from; v < to; v++)
+                               {
+                                   uint64_t key = cheapest[v].load(memory_order_relaxed);
+                                   if (key == UINT64_MAX)
+                                       continue;
+                                   cheapest[v].store(UINT64_MAX, memory_order_relaxed);
+                                   const Edge &edge = edges[(uint32_t)key];
+                                   if (uniteRoots(link, edge.u, edge.v))
+                                       picked[t].push_back(edge);
+                               } });
+        }
+
+        vector<Edge> mst;
+        for (auto &part : picked)
+        {
+            mst.insert(mst.end(), part.begin(), part.end());
+        }
+        return mst;
+    }
+
+    // Helper function to find bridges (critical edges) in the graph.
+    // Walks the indexed adjacency in both directions and skips only the edge it arrived by,
+    // so parallel connections between two devices are never reported as bridges
+    void dfs(int u, int parentEdge, const AdjacencyView &adj, vector<bool> &visited, vector<int> &disc,
+             vector<int> &low, int &time, vector<Edge> &bridges)
     {
-        static int time = 0;
         visited[u] = true;
         disc[u] = low[u] = ++time;
 
-        for (const auto &edge : edges)
+        for (int arc = adj.first[u]; arc < adj.first[u + 1]; arc++)
         {
-            if (edge.u == u)
+            int v = adj.target[arc];
+            int id = adj.edgeId[arc];
+            if (id == parentEdge)
             {
-                int v = edge.v;
-                if (!visited[v])
-                {
-                    parent[v] = u;
-                    dfs(v, visited, disc, low, parent, bridges);
+                continue;
+            }
+            if (!visited[v])
+            {
+                dfs(v, id, adj, visited, disc, low, time, bridges);
 
-                    // Check if the subtree rooted at v has a connection back to one of the ancestors of u
-                    low[u] = min(low[u], low[v]);
+                // Check if the subtree rooted at v has a connection back to one of the ancestors of u
+                low[u] = min(low[u], low[v]);
 
-                    // If the lowest vertex reachable from v is below u in DFS tree, then u-v is a bridge
-                    if (low[v] > disc[u])
-                    {
-                        bridges.push_back(edge);
-                    }
-                }
-                else if (v != parent[u])
+                // If the lowest vertex reachable from v is below u in DFS tree, then u-v is a bridge
+                if (low[v] > disc[u])
                 {
-                    low[u] = min(low[u], disc[v]);
+                    bridges.push_back(edges[id]);
                 }
             }
+            else
+            {
+                low[u] = min(low[u], disc[v]);
+            }
         }
     }
 
     // Function to find all bridges in the graph
     vector<Edge> findBridges()
     {
+        const AdjacencyView &adj = adjacency();
         vector<bool> visited(V, false);
         vector<int> disc(V, -1);
         vector<int> low(V, -1);
-        vector<int> parent(V, -1);
         vector<Edge> bridges;
+        int time = 0;
 
         for (int i = 0; i < V; i++)
         {
             if (!visited[i])
             {
-                dfs(i, visited, disc, low, parent, bridges);
+                dfs(i, -1, adj, visited, disc, low, time, bridges);
             }
         }
 
         return bridges;
     }
+
+private:
+    AdjacencyView view;          // cached adjacency of edges
+    bool adjacencyValid = false; // false once edges changed since the view was built
+
+    // Ranges at most this long are simply sorted by filterKruskal
+    static const size_t FILTER_KRUSKAL_CUTOFF = 1024;
+
+    // Iterative find with path halving
+    int findRoot(vector<int> &parent, int u)
+    {
+        while (parent[u] != u)
+        {
+            parent[u] = parent[parent[u]];
+            u = parent[u];
+        }
+        return u;
+    }
+
+    void filterKruskal(vector<Edge> &work, size_t begin, size_t end, vector<int> &parent, vector<int> &rank,
+                       vector<Edge> &mst)
+    {
+        if (end - begin > FILTER_KRUSKAL_CUTOFF && (int)mst.size() < V - 1)
+        {
+            // Median of three as pivot; light = weight < pivot
+            int a = work[begin].weight, b = work[(begin + end) / 2].weight, c = work[end - 1].weight;
+            int pivot = max(min(a, b), min(max(a, b), c));
+            size_t middle = partition(work.begin() + begin, work.begin() + end, [&](const Edge &e)
+                                      { return e.weight < pivot; }) -
+                            work.begin();
+            if (middle == begin)
+            {
+                // Nothing lighter than the pivot: split off the edges equal to it instead
+                middle = partition(work.begin() + begin, work.begin() + end, [&](const Edge &e)
+                                   { return e.weight == pivot; }) -
+                         work.begin();
+            }
+            if (middle != end)
+            {
+                filterKruskal(work, begin, middle, parent, rank, mst);
+                size_t kept = partition(work.begin() + middle, work.begin() + end, [&](const Edge &e)
+                                               { return findRoot(parent, e.u) != findRoot(parent, e.v); }) -
+                              work.begin();
+                filterKruskal(work, middle, kept, parent, rank, mst);
+                return;
+            }
+        }
+
+        sort(work.begin() + begin, work.begin() + end, [](const Edge &e1, const Edge &e2)
+             { return e1.weight < e2.weight; });
+        for (size_t i = begin; i < end && (int)mst.size() < V - 1; i++)
+        {
+            int ru = findRoot(parent, work[i].u), rv = findRoot(parent, work[i].v);
+            if (ru != rv)
+            {
+                mst.push_back(work[i]);
+                unionSets(parent, rank, ru, rv);
+            }
+        }
+    }
+
+    // Run body(thread, from, to) on one contiguous chunk of [0, count) per thread
+    template <typename Body>
+    static void parallelChunks(size_t count, int numThreads, Body body)
+    {
+        int workers = (int)max<size_t>(1, min<size_t>(numThreads, count / 4096));
+        vector<thread> threads;
+        for (int t = 1; t < workers; t++)
+        {
+            threads.emplace_back(body, t, count * t / workers, count * (t + 1) / workers);
+        }
+        body(0, 0, count / workers);
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+    }
+
+    static void atomicMin(atomic<uint64_t> &slot, uint64_t value)
+    {
+        uint64_t current = slot.load(memory_order_relaxed);
+        while (value < current && !slot.compare_exchange_weak(current, value, memory_order_relaxed))
+        {
+        }
+    }
+
+    // Lock-free union-find: find with path splitting, union links the larger root under the smaller
+    static int findRoot(vector<atomic<int>> &link, int x)
+    {
+        while (true)
+        {
+            int p = link[x].load(memory_order_relaxed);
+            int gp = link[p].load(memory_order_relaxed);
+            if (p == gp)
+            {
+                return p;
+            }
+            link[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    // Returns false if a and b were already in one set
+    static bool uniteRoots(vector<atomic<int>> &link, int a, int b)
+    {
+        while (true)
+        {
+            a = findRoot(link, a);
+            b = findRoot(link, b);
+            if (a == b)
+            {
+                return false;
+            }
+            if (a < b)
+            {
+                swap(a, b);
+            }
+            int expected = a;
+            if (link[a].compare_exchange_strong(expected, b))
+            {
+                return true;
+            }
+        }
+    }
+};
+
+// Online bridge maintenance under edge insertions. Vertices are grouped into 2-edge-connected
+// components (union-find), and the components form a spanning forest whose links are exactly
+// the bridges. Joining two trees reroots the smaller one (O(log n) amortized); an edge inside
+// one tree closes a cycle, and every component on the tree path is merged into the LCA
+class OnlineBridges
+{
+public:
+    OnlineBridges(int n)
+        : parent(n, -1), twoEdge(n), connected(n), treeSize(n, 1), lastVisit(n, 0), linkEdge(n, Edge(-1, -1, 0))
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            twoEdge[i] = connected[i] = i;
+        }
+    }
+
+    // Insert an edge; the bridge set is up to date when this returns
+    void addEdge(int u, int v, int weight)
+    {
+        int a = find2EdgeComponent(u), b = find2EdgeComponent(v);
+        if (a == b)
+        {
+            return;
+        }
+
+        int ca = findTree(a), cb = findTree(b);
+        if (ca != cb)
+        {
+            // New bridge between two trees: hang the smaller tree below the other
+            if (treeSize[ca] > treeSize[cb])
+            {
+                swap(a, b);
+                swap(ca, cb);
+            }
+            makeRoot(a);
+            parent[a] = connected[a] = b;
+            linkEdge[a] = Edge(u, v, weight);
+            treeSize[cb] += treeSize[a];
+            bridgeCount++;
+        }
+        else
+        {
+            mergePath(a, b);
+        }
+    }
+
+    int numBridges() const
+    {
+        return bridgeCount;
+    }
+
+    // Current bridges: the tree link above every component that has a parent
+    vector<Edge> bridges()
+    {
+        vector<Edge> result;
+        for (int v = 0; v < (int)parent.size(); ++v)
+        {
+            if (find2EdgeComponent(v) == v && parent[v] != -1)
+            {
+                result.push_back(linkEdge[v]);
+            }
+        }
+        return result;
+    }
+
+private:
+    vector<int> parent;    // forest parent of a component (any vertex of it, -1 for a root)
+    vector<int> twoEdge;   // union-find of 2-edge-connected components
+    vector<int> connected; // union-find of trees (connected components)
+    vector<int> treeSize;  // number of components in a tree, valid at the tree's root
+    vector<int> lastVisit; // LCA search marks
+    vector<Edge> linkEdge; // edge between a component and its forest parent
+    int bridgeCount = 0;
+    int visitStamp = 0;
+
+    int find2EdgeComponent(int v)
+    {
+        if (v == -1)
+        {
+            return -1;
+        }
+        int root = v;
+        while (twoEdge[root] != root)
+        {
+            root = twoEdge[root];
+        }
+        while (twoEdge[v] != root)
+        {
+            int next = twoEdge[v];
+            twoEdge[v] = root;
+            v = next;
+        }
+        return root;
+    }
+
+    int findTree(int v)
+    {
+        v = find2EdgeComponent(v);
+        int root = v;
+        while (connected[root] != root)
+        {
+            root = connected[root];
+        }
+        while (connected[v] != root)
+        {
+            int next = connected[v];
+            connected[v] = root;
+            v = next;
+        }
+        return root;
+    }
+
+    // Reverse the parent pointers from v up to its root so that v becomes the root
+    void makeRoot(int v)
+    {
+        v = find2EdgeComponent(v);
+        int root = v, child = -1;
+        Edge childEdge(-1, -1, 0);
+        while (v != -1)
+        {
+            int next = find2EdgeComponent(parent[v]);
+            Edge up = linkEdge[v];
+            parent[v] = child;
+            linkEdge[v] = childEdge;
+            connected[v] = root;
+            child = v;
+            childEdge = up;
+            v = next;
+        }
+        treeSize[root] = treeSize[child];
+    }
+
+    // Merge every component on the tree path between a and b into their LCA
+    void mergePath(int a, int b)
+    {
+        ++visitStamp;
+        vector<int> pathA, pathB;
+        int lca = -1;
+        while (lca == -1)
+        {
+            if (a != -1)
+            {
+                a = find2EdgeComponent(a);
+                pathA.push_back(a);
+                if (lastVisit[a] == visitStamp)
+                {
+                    lca = a;
+                    break;
+                }
+                lastVisit[a] = visitStamp;
+                a = parent[a];
+            }
+            if (b != -1)
+            {
+                b = find2EdgeComponent(b);
+                pathB.push_back(b);
+                if (lastVisit[b] == visitStamp)
+                {
+                    lca = b;
+                    break;
+                }
+                lastVisit[b] = visitStamp;
+                b = parent[b];
+            }
+        }
+
+        for (const vector<int> *path : {&pathA, &pathB})
+        {
+            for (int v : *path)
+            {
+                twoEdge[v] = lca;
+                if (v == lca)
+                {
+                    break;
+                }
+                bridgeCount--;
+            }
+        }
+    }
+};
+
+// Dynamic MST under edge insertions and weight decreases. The spanning forest lives in a
+// link-cut tree where every edge is its own node between its two endpoints, so a path query
+// finds the heaviest tree edge between u and v. A new (or cheaper) edge that beats that
+// maximum replaces it; all updates are O(log n) amortized
+class DynamicMST
+{
+public:
+    DynamicMST(int n) : n(n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            newNode(INT_MIN);
+        }
+    }
+
+    // Insert an edge and return its id; the forest is a minimum spanning forest when this returns
+    int addEdge(int u, int v, int weight)
+    {
+        edges.push_back(Edge(u, v, weight));
+        inTree.push_back(false);
+        newNode(weight);
+        int id = (int)edges.size() - 1;
+        offer(id);
+        return id;
+    }
+
+    // Lower the weight of an existing edge (larger weights are ignored)
+    void decreaseWeight(int id, int weight)
+    {
+        if (weight >= edges[id].weight)
+        {
+            return;
+        }
+        if (inTree[id])
+        {
+            totalWeight -= edges[id].weight - weight;
+            edges[id].weight = weight;
+            int x = n + id;
+            splay(x);
+            value[x] = weight;
+            pull(x);
+            return;
+        }
+        edges[id].weight = weight;
+        value[n + id] = weight;
+        pull(n + id);
+        offer(id);
+    }
+
+    long long weight() const
+    {
+        return totalWeight;
+    }
+
+    int treeSize() const
+    {
+        return treeEdges;
+    }
+
+    const Edge &edge(int id) const
+    {
+        return edges[id];
+    }
+
+    // Current forest edges
+    vector<Edge> spanningForest() const
+    {
+        vector<Edge> result;
+        for (int id = 0; id < (int)edges.size(); ++id)
+        {
+            if (inTree[id])
+            {
+                result.push_back(edges[id]);
+            }
+        }
+        return result;
+    }
+
+private:
+    int n;                 // vertices are nodes 0 .. n - 1, edge id is node n + id
+    vector<Edge> edges;
+    vector<bool> inTree;
+    vector<int> child[2], up, value, maxNode; // splay trees of the link-cut tree; maxNode is the heaviest node of a subtree
+    vector<bool> flip;     // lazy subtree reversal
+    vector<int> splayPath; // scratch for splay()
+    long long totalWeight = 0;
+    int treeEdges = 0;
+
+    void newNode(int weight)
+    {
+        child[0].push_back(-1);
+        child[1].push_back(-1);
+        up.push_back(-1);
+        value.push_back(weight);
+        maxNode.push_back((int)value.size() - 1);
+        flip.push_back(false);
+    }
+
+    // Link edge id into the forest, or swap it for the heaviest edge on the cycle it closes
+    void offer(int id)
+    {
+        int u = edges[id].u, v = edges[id].v;
+        if (u == v)
+        {
+            return;
+        }
+        if (findRoot(u) == findRoot(v))
+        {
+            makeRoot(u);
+            access(v);
+            splay(v);
+            int heaviest = maxNode[v];
+            if (value[heaviest] <= edges[id].weight)
+            {
+                return;
+            }
+            int old = heaviest - n;
+            cut(heaviest, edges[old].u);
+            cut(heaviest, edges[old].v);
+            inTree[old] = false;
+            totalWeight -= edges[old].weight;
+            treeEdges--;
+        }
+        link(u, n + id);
+        link(n + id, v);
+        inTree[id] = true;
+        totalWeight += edges[id].weight;
+        treeEdges++;
+    }
+
+    bool isRoot(int x) const
+    {
+        int p = up[x];
+        return p == -1 || (child[0][p] != x && child[1][p] != x);
+    }
+
+    void pull(int x)
+    {
+        maxNode[x] = x;
+        for (int side = 0; side < 2; ++side)
+        {
+            int c = child[side][x];
+            if (c != -1 && value[maxNode[c]] > value[maxNode[x]])
+            {
+                maxNode[x] = maxNode[c];
+            }
+        }
+    }
+
+    void push(int x)
+    {
+        if (flip[x])
+        {
+            swap(child[0][x], child[1][x]);
+            for (int side = 0; side < 2; ++side)
+            {
+                if (child[side][x] != -1)
+                {
+                    flip[child[side][x]] = !flip[child[side][x]];
+                }
+            }
+            flip[x] = false;
+        }
+    }
+
+    void rotate(int x)
+    {
+        int p = up[x], g = up[p];
+        int side = child[1][p] == x;
+        if (!isRoot(p))
+        {
+            child[child[1][g] == p][g] = x;
+        }
+        up[x] = g;
+        child[side][p] = child[!side][x];
+        if (child[side][p] != -1)
+        {
+            up[child[side][p]] = p;
+        }
+        child[!side][x] = p;
+        up[p] = x;
+        pull(p);
+        pull(x);
+    }
+
+    void splay(int x)
+    {
+        // Push pending reversals top-down along the splay path first
+        vector<int> &path = splayPath;
+        path.clear();
+        for (int y = x;; y = up[y])
+        {
+            path.push_back(y);
+            if (isRoot(y))
+            {
+                break;
+            }
+        }
+        for (int i = (int)path.size() - 1; i >= 0; --i)
+        {
+            push(path[i]);
+        }
+        while (!isRoot(x))
+        {
+            int p = up[x];
+            if (!isRoot(p))
+            {
+                int g = up[p];
+                rotate((child[0][g] == p) == (child[0][p] == x) ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    // Make the root-to-x path preferred, with x at the root of its splay tree
+    void access(int x)
+    {
+        for (int last = -1, y = x; y != -1; last = y, y = up[y])
+        {
+            splay(y);
+            child[1][y] = last;
+            pull(y);
+        }
+        splay(x);
+    }
+
+    void makeRoot(int x)
+    {
+        access(x);
+        flip[x] = !flip[x];
+    }
+
+    int findRoot(int x)
+    {
+        access(x);
+        while (true)
+        {
+            push(x);
+            if (child[0][x] == -1)
+            {
+                break;
+            }
+            x = child[0][x];
+        }
+        splay(x);
+        return x;
+    }
+
+    void link(int x, int y)
+    {
+        makeRoot(x);
+        up[x] = y;
+    }
+
+    void cut(int x, int y)
+    {
+        makeRoot(x);
+        access(y);
+        // x is now the left child of y with no right child of its own
+        child[0][y] = -1;
+        up[x] = -1;
+        pull(y);
+    }
+};
+
+// Edge as stored in binary edge files (three int32 values per edge)
+struct EdgeRecord
+{
+    int u, v, weight;
+};
+
+// Write edges to a binary edge file usable by ExternalMST
+bool writeEdgeFile(const string &path, const vector<Edge> &edges)
+{
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+    for (const auto &edge : edges)
+    {
+        EdgeRecord record = {edge.u, edge.v, edge.weight};
+        fwrite(&record, sizeof(record), 1, file);
+    }
+    return fclose(file) == 0;
+}
+
+// Out-of-core MST for edge files larger than RAM (semi-external: the union-find over the
+// vertices stays in memory, the edges stay on disk). The edge file is cut into sorted runs of
+// memoryBytes each, runs are merged with fixed-size buffers (several passes if there are too
+// many runs for one), and the last merge streams straight into Kruskal and stops reading as
+// soon as the spanning tree has V - 1 edges
+class ExternalMST
+{
+public:
+    long long bytesRead = 0;    // I/O volume of the last run()
+    long long bytesWritten = 0;
+    int runsCreated = 0;
+    int mergePasses = 0;
+
+    ExternalMST(size_t memoryBytes, const string &tempPrefix) : memoryBytes(memoryBytes), tempPrefix(tempPrefix) {}
+
+    // MST of the graph with V vertices whose edges are in edgeFile. Returns false (and removes
+    // its temporary files) if a file cannot be opened, read or written, or if an edge has an
+    // endpoint outside [0, V)
+    bool run(const string &edgeFile, int V, vector<Edge> &mst)
+    {
+        bytesRead = bytesWritten = 0;
+        runsCreated = mergePasses = 0;
+        failed = false;
+        mst.clear();
+
+        vector<string> runs = createRuns(edgeFile, V);
+        if (failed)
+        {
+            discard(runs);
+            return false;
+        }
+        if (runs.empty())
+        {
+            return true;
+        }
+
+        // Merge until one pass with one buffer per run fits in memory
+        size_t fanIn = max<size_t>(3, memoryBytes / BLOCK_BYTES) - 1; // one block stays for the output
+        int generation = 0;
+        while (runs.size() > fanIn && !failed)
+        {
+            vector<string> merged;
+            for (size_t first = 0; first < runs.size(); first += fanIn)
+            {
+                string output = tempPrefix + "merge" + to_string(generation) + "_" + to_string(merged.size());
+                FILE *out = failed ? nullptr : fopen(output.c_str(), "wb");
+                if (!out)
+                {
+                    failed = true;
+                    discard(vector<string>(runs.begin() + first, runs.end()));
+                    break;
+                }
+                vector<string> group(runs.begin() + first, runs.begin() + min(runs.size(), first + fanIn));
+                vector<EdgeRecord> buffer;
+                buffer.reserve(BLOCK_BYTES / sizeof(EdgeRecord));
+                mergeRuns(group, [&](const EdgeRecord &record)
+                          {
+                              buffer.push_back(record);
+                              if (buffer.size() == buffer.capacity())
+                                  flush(out, buffer);
+                              return true; });
+                flush(out, buffer);
+                if (fclose(out) != 0)
+                {
+                    failed = true;
+                }
+                merged.push_back(output);
+            }
+            runs = merged;
+            generation++;
+            mergePasses++;
+        }
+        if (failed)
+        {
+            discard(runs);
+            return false;
+        }
+
+        // Final merge feeds Kruskal directly
+        vector<int> parent(V);
+        for (int i = 0; i < V; i++)
+        {
+            parent[i] = i;
+        }
+        mergeRuns(runs, [&](const EdgeRecord &record)
+                  {
+                      int ru = find(parent, record.u), rv = find(parent, record.v);
+                      if (ru != rv)
+                      {
+                          parent[ru] = rv;
+                          mst.push_back(Edge(record.u, record.v, record.weight));
+                      }
+                      return (int)mst.size() < V - 1; });
+        mergePasses++;
+        return !failed;
+    }
+
+private:
+    static const size_t BLOCK_BYTES = 1 << 16; // read/write buffer per open run
+
+    size_t memoryBytes;
+    string tempPrefix;
+    bool failed = false; // an I/O error or a bad edge was seen during the current run()
+
+    static int find(vector<int> &parent, int u)
+    {
+        while (parent[u] != u)
+        {
+            parent[u] = parent[parent[u]];
+            u = parent[u];
+        }
+        return u;
+    }
+
+    static void discard(const vector<string> &runs)
+    {
+        for (const string &path : runs)
+        {
+            remove(path.c_str());
+        }
+    }
+
+    void flush(FILE *out, vector<EdgeRecord> &buffer)
+    {
+        if (fwrite(buffer.data(), sizeof(EdgeRecord), buffer.size(), out) != buffer.size())
+        {
+            failed = true;
+        }
+        bytesWritten += buffer.size() * sizeof(EdgeRecord);
+        buffer.clear();
+    }
+
+    // Read memoryBytes of edges at a time, sort them by weight and spill each chunk as a run.
+    // Every edge passes through here once, so this is where vertex ids are checked against V
+    vector<string> createRuns(const string &edgeFile, int V)
+    {
+        vector<string> runs;
+        FILE *in = fopen(edgeFile.c_str(), "rb");
+        if (!in)
+        {
+            failed = true;
+            return runs;
+        }
+        vector<EdgeRecord> chunk(max<size_t>(1, memoryBytes / sizeof(EdgeRecord)));
+        size_t count;
+        while (!failed && (count = fread(chunk.data(), sizeof(EdgeRecord), chunk.size(), in)) > 0)
+        {
+            bytesRead += count * sizeof(EdgeRecord);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (chunk[i].u < 0 || chunk[i].u >= V || chunk[i].v < 0 || chunk[i].v >= V)
+                {
+                    failed = true;
+                }
+            }
+            if (failed)
+            {
+                break;
+            }
+            sort(chunk.begin(), chunk.begin() + count, [](const EdgeRecord &a, const EdgeRecord &b)
+                 { return a.weight < b.weight; });
+
+            string path = tempPrefix + "run" + to_string(runs.size());
+            FILE *out = fopen(path.c_str(), "wb");
+            if (!out)
+            {
+                failed = true;
+                break;
+            }
+            runs.push_back(path);
+            if (fwrite(chunk.data(), sizeof(EdgeRecord), count, out) != count || fclose(out) != 0)
+            {
+                failed = true;
+            }
+            bytesWritten += count * sizeof(EdgeRecord);
+        }
+        if (ferror(in))
+        {
+            failed = true;
+        }
+        fclose(in);
+        runsCreated = runs.size();
+        return runs;
+    }
+
+    // k-way merge of sorted runs through one BLOCK_BYTES buffer each. The sink returns false to
+    // stop early; the runs are deleted afterwards either way
+    template <typename Sink>
+    void mergeRuns(const vector<string> &runs, Sink sink)
+    {
+        struct Reader
+        {
+            FILE *file;
+            vector<EdgeRecord> buffer;
+            size_t pos, count;
+        };
+        vector<Reader> readers(runs.size());
+        auto refill = [&](Reader &reader)
+        {
+            reader.count = fread(reader.buffer.data(), sizeof(EdgeRecord), reader.buffer.size(), reader.file);
+            reader.pos = 0;
+            bytesRead += reader.count * sizeof(EdgeRecord);
+            return reader.count > 0;
+        };
+
+        // (weight, reader index), smallest weight first
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> heap;
+        for (size_t r = 0; r < runs.size(); r++)
+        {
+            readers[r].file = fopen(runs[r].c_str(), "rb");
+            readers[r].buffer.resize(BLOCK_BYTES / sizeof(EdgeRecord));
+            if (!readers[r].file)
+            {
+                failed = true;
+            }
+            else if (refill(readers[r]))
+            {
+                heap.push({readers[r].buffer[0].weight, (int)r});
+            }
+        }
+
+        while (!heap.empty() && !failed)
+        {
+            Reader &reader = readers[heap.top().second];
+            int r = heap.top().second;
+            heap.pop();
+            if (!sink(reader.buffer[reader.pos++]))
+            {
+                break;
+            }
+            if (reader.pos < reader.count || refill(reader))
+            {
+                heap.push({reader.buffer[reader.pos].weight, r});
+            }
+        }
+
+        for (size_t r = 0; r < runs.size(); r++)
+        {
+            if (readers[r].file)
+            {
+                if (ferror(readers[r].file))
+                {
+                    failed = true;
+                }
+                fclose(readers[r].file);
+            }
+            remove(runs[r].c_str());
+        }
+    }
 };
 
 // Helper function to print the MST edges
@@ -167,12 +1163,163 @@ void printBridges(const vector<Edge> &bridges)
     }
 }
 
-int main()
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name: Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
     cout << "\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        // Random link insertions into a 1,000,000-device network
+        int n = 1000000, links = 3000000;
+        OnlineBridges online(n);
+        unsigned seed = 9;
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < links; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            online.addEdge(u, (seed >> 8) % n, 1);
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        cout << links << " insertions: " << ms * 1e6 / links << " ns each, " << online.numBridges() << " bridges" << endl;
+
+        // MST on a random graph: "15 bench <edges>" (default 5M edges, 10 edges per vertex)
+        long long edgeCount = argc > 2 ? atoll(argv[2]) : 5000000;
+        Graph random(max(2LL, edgeCount / 10));
+        random.edges.reserve(edgeCount);
+        for (long long i = 0; i < edgeCount; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % random.V;
+            seed = seed * 1103515245u + 12345u;
+            int v = (seed >> 8) % random.V;
+            seed = seed * 1103515245u + 12345u;
+            random.edges.push_back(Edge(u, v, (seed >> 8) % 1000000));
+        }
+        random.invalidateAdjacency();
+
+        auto report = [&](const string &name, const vector<Edge> &mst, double elapsed)
+        {
+            long long total = 0;
+            for (const auto &edge : mst)
+            {
+                total += edge.weight;
+            }
+            cout << name << ": " << elapsed << " ms, " << mst.size() << " edges, total weight " << total << endl;
+            return total;
+        };
+        cout << "MST of " << random.V << " vertices, " << edgeCount << " edges" << endl;
+
+        begin = chrono::steady_clock::now();
+        vector<Edge> mst = random.filterKruskalMST();
+        long long staticWeight = report("Filter-Kruskal", mst,
+                                        chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count());
+
+        int maxThreads = max(4u, thread::hardware_concurrency());
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            begin = chrono::steady_clock::now();
+            mst = random.boruvkaMST(threads);
+            long long boruvkaWeight = report("Boruvka, " + to_string(threads) + " threads", mst,
+                                             chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count());
+            if (boruvkaWeight != staticWeight)
+            {
+                cout << "MISMATCH: Boruvka weight " << boruvkaWeight << " with " << threads << " threads, Filter-Kruskal "
+                     << staticWeight << endl;
+                return 1;
+            }
+        }
+
+        // Dynamic MST: the same edges arrive one at a time, then random weight decreases
+        DynamicMST dynamic(random.V);
+        begin = chrono::steady_clock::now();
+        for (const auto &edge : random.edges)
+        {
+            dynamic.addEdge(edge.u, edge.v, edge.weight);
+        }
+        ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        cout << "Dynamic MST: " << ms * 1e6 / edgeCount << " ns per insertion, total weight " << dynamic.weight() << endl;
+        if (dynamic.weight() != staticWeight)
+        {
+            cout << "MISMATCH: dynamic MST weight " << dynamic.weight() << " after insertions, Filter-Kruskal "
+                 << staticWeight << endl;
+            return 1;
+        }
+        int decreases = 200000;
+        begin = chrono::steady_clock::now();
+        for (int i = 0; i < decreases; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int id = (seed >> 8) % edgeCount;
+            dynamic.decreaseWeight(id, dynamic.edge(id).weight / 2);
+            random.edges[id].weight = dynamic.edge(id).weight;
+        }
+        ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        cout << "Dynamic MST: " << ms * 1e6 / decreases << " ns per weight decrease, total weight " << dynamic.weight() << endl;
+
+        begin = chrono::steady_clock::now();
+        mst = random.kruskalMST();
+        long long rerunWeight = report("Kruskal (sort everything)", mst,
+                                       chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count());
+        if (dynamic.weight() != rerunWeight)
+        {
+            cout << "MISMATCH: dynamic MST weight " << dynamic.weight() << " after decreases, Kruskal rerun "
+                 << rerunWeight << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (argc > 1 && string(argv[1]) == "external")
+    {
+        // "15 external <edges> <memory MB>": MST of a random edge file with limited memory
+        long long edgeCount = argc > 2 ? atoll(argv[2]) : 5000000;
+        size_t memoryMB = argc > 3 ? atoll(argv[3]) : 8;
+        Graph random(max(2LL, edgeCount / 10));
+        unsigned seed = 21;
+        for (long long i = 0; i < edgeCount; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % random.V;
+            seed = seed * 1103515245u + 12345u;
+            int v = (seed >> 8) % random.V;
+            seed = seed * 1103515245u + 12345u;
+            random.addEdge(u, v, (seed >> 8) % 1000000);
+        }
+        string edgeFile = "edges.bin";
+        if (!writeEdgeFile(edgeFile, random.edges))
+        {
+            cout << "Cannot write " << edgeFile << endl;
+            return 1;
+        }
+
+        ExternalMST external(memoryMB << 20, "mst_tmp_");
+        auto begin = chrono::steady_clock::now();
+        vector<Edge> mst;
+        bool ok = external.run(edgeFile, random.V, mst);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        remove(edgeFile.c_str());
+        if (!ok)
+        {
+            cout << "External MST failed (I/O error or vertex id out of range)" << endl;
+            return 1;
+        }
+
+        long long total = 0, expected = 0;
+        for (const auto &edge : mst)
+            total += edge.weight;
+        for (const auto &edge : random.filterKruskalMST())
+            expected += edge.weight;
+        cout << "External MST: " << ms << " ms with " << memoryMB << " MB, " << external.runsCreated << " runs, "
+             << external.mergePasses << " merge passes, read " << (external.bytesRead >> 20) << " MB, wrote "
+             << (external.bytesWritten >> 20) << " MB, total weight " << total
+             << (total == expected ? " (matches in-memory MST)" : " (MISMATCH)") << endl;
+        return 0;
+    }
+
     // Create a graph representing the network with 5 devices
     Graph g(5);
     g.addEdge(0, 1, 10);
@@ -183,12 +1330,34 @@ int main()
     g.addEdge(3, 4, 60);
 
     // Find the MST (optimized network topology for minimum cost)
-    vector<Edge> mst = g.kruskalMST();
+    vector<Edge> mst = g.filterKruskalMST();
     printMST(mst);
 
+    // Keep the MST up to date while a cheap link is added and another gets cheaper
+    DynamicMST dynamic(g.V);
+    for (const auto &edge : g.edges)
+    {
+        dynamic.addEdge(edge.u, edge.v, edge.weight);
+    }
+    cout << "Dynamic MST weight: " << dynamic.weight() << endl;
+    dynamic.addEdge(2, 4, 15);
+    cout << "After adding 2 - 4 (15): " << dynamic.weight() << endl;
+    dynamic.decreaseWeight(1, 5);
+    cout << "After 0 - 2 drops to 5: " << dynamic.weight() << endl;
+    printMST(dynamic.spanningForest());
+
     // Find bridges (critical edges)
     vector<Edge> bridges = g.findBridges();
     printBridges(bridges);
+
+    // Maintain the bridges online while the same links arrive one at a time
+    OnlineBridges online(g.V);
+    for (const auto &edge : g.edges)
+    {
+        online.addEdge(edge.u, edge.v, edge.weight);
+        cout << "After adding " << edge.u << " - " << edge.v << ": " << online.numBridges() << " bridges" << endl;
+    }
+    printBridges(online.bridges());
     system("pause");
     return 0;
 }
@@ -1,7 +1,11 @@
 #include <iostream>
-#include <queue>
+#include <vector>
+#include <algorithm>
 #include <cmath>
-#include <cstring> // For memset
+#include <cstdint>
+#include <memory>
+#include <chrono>
+#include <string>
 
 using namespace std;
 
@@ -9,8 +13,6 @@ using namespace std;
 const int dx[] = {0, 1, 0, -1};
 const int dy[] = {1, 0, -1, 0};
 
-const int MAX_SIZE = 100; // Maximum grid size
-
 // Node structure to hold the data for each cell
 struct Node
 {
@@ -19,6 +21,7 @@ struct Node
     int h;        // Heuristic cost (estimated distance to goal)
     int f;        // Total cost (f = g + h)
     Node *parent; // Pointer to the parent node to reconstruct the path
+    int id = 0;   // Slot in the node arena, used as the open-list key
 
     // Constructor to initialize a node
     Node(int x = 0, int y = 0, int g = 0, int h = 0, Node *parent = nullptr)
@@ -26,11 +29,285 @@ struct Node
     {
         f = g + h;
     }
+};
+
+// Grid map sized at runtime. Passability is one bit per cell (1 = obstacle), rows padded to a
+// multiple of 256 bits so a row can be scanned a word (or a SIMD register) at a time; padding
+// bits are set, so cells past the last column read as obstacles. Optional 8-bit costs give the
+// price of entering a cell (1..255, 1 everywhere until the first setCost)
+class GridMap
+{
+public:
+    int rows, cols;
+
+    GridMap(int rows, int cols)
+        : rows(rows), cols(cols), wordsPerRow((cols + 255) / 256 * 4), bits((size_t)rows * wordsPerRow, 0),
+          obstaclesInRow(rows, 0), summaryPerRow((wordsPerRow + 63) / 64), busy((size_t)rows * summaryPerRow, 0)
+    {
+        for (int x = 0; x < rows; ++x)
+        {
+            for (int y = cols; y < wordsPerRow * 64; ++y)
+            {
+                bits[(size_t)x * wordsPerRow + y / 64] |= 1ULL << (y % 64);
+                busy[(size_t)x * summaryPerRow + y / 4096] |= 1ULL << (y / 64 % 64);
+            }
+        }
+    }
+
+    bool blocked(int x, int y) const
+    {
+        return bits[(size_t)x * wordsPerRow + y / 64] >> (y % 64) & 1;
+    }
+
+    void setBlocked(int x, int y, bool obstacle = true)
+    {
+        uint64_t &word = bits[(size_t)x * wordsPerRow + y / 64];
+        obstaclesInRow[x] += (int)obstacle - (int)(word >> (y % 64) & 1);
+        word = obstacle ? word | 1ULL << (y % 64) : word & ~(1ULL << (y % 64));
+        uint64_t &summary = busy[(size_t)x * summaryPerRow + y / 4096];
+        summary = word ? summary | 1ULL << (y / 64 % 64) : summary & ~(1ULL << (y / 64 % 64));
+    }
+
+    // True if row x has no obstacle (rows outside the map count as clear)
+    bool rowClear(int x) const
+    {
+        return x < 0 || x >= rows || obstaclesInRow[x] == 0;
+    }
+
+    void setCost(int x, int y, uint8_t cost)
+    {
+        cost = max<uint8_t>(cost, 1);
+        if (costs.empty())
+        {
+            if (cost == 1)
+            {
+                return; // Still uniform, no need for the cost array
+            }
+            costs.assign((size_t)rows * cols, 1);
+            costCount[1] = costs.size();
+        }
+        uint8_t &cell = costs[(size_t)x * cols + y];
+        costCount[cell]--;
+        costCount[cost]++;
+        cell = cost;
+        if (cost < lowestCost)
+        {
+            lowestCost = cost;
+        }
+        while (costCount[lowestCost] == 0)
+        {
+            lowestCost++; // The last cell at the old minimum got more expensive
+        }
+    }
+
+    // Cost of moving into (x, y)
+    int cost(int x, int y) const
+    {
+        return costs.empty() ? 1 : costs[(size_t)x * cols + y];
+    }
+
+    // Cheapest cell on the map, a lower bound for admissible heuristics
+    int minCost() const
+    {
+        return lowestCost;
+    }
+
+    // True while every cell costs 1 (including after costs were set and reset to 1)
+    bool uniformCost() const
+    {
+        return costs.empty() || costCount[1] == costs.size();
+    }
+
+    // Obstacle bits of row x, wordsPerRow() words
+    const uint64_t *row(int x) const
+    {
+        return &bits[(size_t)x * wordsPerRow];
+    }
+
+    int rowWords() const
+    {
+        return wordsPerRow;
+    }
+
+    // Summary of row x, summaryWords() words: bit w is set if word w of row(x) is not zero
+    const uint64_t *rowSummary(int x) const
+    {
+        return &busy[(size_t)x * summaryPerRow];
+    }
+
+    int summaryWords() const
+    {
+        return summaryPerRow;
+    }
+
+    size_t memoryBytes() const
+    {
+        return (bits.size() + busy.size()) * sizeof(uint64_t) + obstaclesInRow.size() * sizeof(int) + costs.size();
+    }
+
+private:
+    int wordsPerRow;
+    vector<uint64_t> bits;
+    vector<int> obstaclesInRow;
+    int summaryPerRow;
+    vector<uint64_t> busy;
+    vector<uint8_t> costs;
+    size_t costCount[256] = {}; // cells per cost value, kept once costs exist
+    int lowestCost = 1;
+};
+
+// Bitmap with the row layout of a GridMap, cleared bit by bit so a query only pays for what
+// it touched
+class CellBitmap
+{
+public:
+    void resize(const GridMap &grid)
+    {
+        wordsPerRow = grid.rowWords();
+        bits.assign((size_t)grid.rows * wordsPerRow, 0);
+    }
+
+    bool test(int x, int y) const
+    {
+        return bits[(size_t)x * wordsPerRow + y / 64] >> (y % 64) & 1;
+    }
+
+    void set(int x, int y)
+    {
+        bits[(size_t)x * wordsPerRow + y / 64] |= 1ULL << (y % 64);
+    }
+
+    void reset(int x, int y)
+    {
+        bits[(size_t)x * wordsPerRow + y / 64] &= ~(1ULL << (y % 64));
+    }
 
-    // Comparison operator to make Node work in a priority queue (min-heap)
-    bool operator>(const Node &other) const
+private:
+    int wordsPerRow = 0;
+    vector<uint64_t> bits;
+};
+
+// Min-heap of node ids ordered by (f, h) with four children per slot. pos maps every id to its
+// slot (-1 when absent), so an improved node has its key lowered in place instead of being
+// pushed again. The position array grows with the ids in use and is reused across queries
+class IndexedHeap
+{
+public:
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    bool contains(int id) const
+    {
+        return id < (int)pos.size() && pos[id] != -1;
+    }
+
+    // Insert id, or lower its key if it is already queued
+    void push(int id, int f, int h)
+    {
+        if (id >= (int)pos.size())
+        {
+            pos.resize(max<size_t>(id + 1, 2 * pos.size()), -1);
+        }
+        int slot = pos[id];
+        if (slot == -1)
+        {
+            slot = heap.size();
+            heap.push_back({f, h, id});
+        }
+        else
+        {
+            heap[slot].f = f;
+            heap[slot].h = h;
+        }
+        siftUp(slot);
+    }
+
+    int pop()
+    {
+        int top = heap[0].id;
+        pos[top] = -1;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    // Empty the heap; only the ids still queued need their positions reset
+    void clear()
+    {
+        for (const Entry &entry : heap)
+        {
+            pos[entry.id] = -1;
+        }
+        heap.clear();
+    }
+
+private:
+    struct Entry
+    {
+        int f, h, id;
+        bool operator<(const Entry &other) const
+        {
+            return f < other.f || (f == other.f && h < other.h); // prefer nodes closer to the goal
+        }
+    };
+    vector<Entry> heap;
+    vector<int> pos;
+
+    void siftUp(int slot)
+    {
+        Entry entry = heap[slot];
+        while (slot > 0)
+        {
+            int parent = (slot - 1) / 4;
+            if (!(entry < heap[parent]))
+            {
+                break;
+            }
+            heap[slot] = heap[parent];
+            pos[heap[slot].id] = slot;
+            slot = parent;
+        }
+        heap[slot] = entry;
+        pos[entry.id] = slot;
+    }
+
+    void siftDown(int slot)
     {
-        return f > other.f; // We want the smallest f value at the top
+        Entry entry = heap[slot];
+        int size = heap.size();
+        while (true)
+        {
+            int first = 4 * slot + 1;
+            if (first >= size)
+            {
+                break;
+            }
+            int best = first;
+            for (int c = first + 1; c < min(first + 4, size); ++c)
+            {
+                if (heap[c] < heap[best])
+                {
+                    best = c;
+                }
+            }
+            if (!(heap[best] < entry))
+            {
+                break;
+            }
+            heap[slot] = heap[best];
+            pos[heap[slot].id] = slot;
+            slot = best;
+        }
+        heap[slot] = entry;
+        pos[entry.id] = slot;
     }
 };
 
@@ -38,70 +315,73 @@ struct Node
 class AStar
 {
 public:
-    AStar(int rows, int cols, int grid[MAX_SIZE][MAX_SIZE])
-        : rows(rows), cols(cols)
+    // The grid is used by reference and must outlive the AStar
+    AStar(const GridMap &grid) : grid(grid)
     {
-        // Copy grid data
-        memcpy(this->grid, grid, sizeof(this->grid));
+        seen.resize(grid);
+        closed.resize(grid);
+        tilesPerRow = (grid.cols + 63) / 64;
+        tileOf.assign((size_t)(grid.rows + 63) / 64 * tilesPerRow, -1);
     }
 
-    // Perform the A* search to find the shortest path
+    // Perform the A* search to find the shortest path. The returned node and its parents live
+    // in the node arena of this AStar and stay valid until the next findPath call. Node
+    // records and cell-to-node tiles exist only where the search went, so memory follows the
+    // search, not the map
     Node *findPath(pair<int, int> start, pair<int, int> goal)
     {
-        priority_queue<Node, deque<Node>, greater<Node>> openList;
-        bool closedList[MAX_SIZE][MAX_SIZE] = {false};
-
         int startX = start.first, startY = start.second;
         int goalX = goal.first, goalY = goal.second;
-
-        // Allocate nodes dynamically to avoid stack overflow for large grids
-        Node *nodes[MAX_SIZE][MAX_SIZE];
-        memset(nodes, 0, sizeof(nodes));
+        reset();
 
         // Create the starting node and push it into the open list
-        nodes[startX][startY] = new Node(startX, startY, 0, heuristic(startX, startY, goalX, goalY));
-        openList.push(*nodes[startX][startY]);
+        Node *startNode = newNode(startX, startY, 0, heuristic(startX, startY, goalX, goalY), nullptr);
+        openList.push(startNode->id, startNode->f, startNode->h);
 
         while (!openList.empty())
         {
-            Node current = openList.top();
-            openList.pop();
+            Node &current = node(openList.pop());
+            closed.set(current.x, current.y);
+            expanded++;
 
             if (current.x == goalX && current.y == goalY)
             {
                 // Goal reached
-                return nodes[current.x][current.y];
+                return &current;
             }
 
-            closedList[current.x][current.y] = true;
-
             // Check all 4 possible directions (up, down, left, right)
             for (int i = 0; i < 4; ++i)
             {
                 int newX = current.x + dx[i];
                 int newY = current.y + dy[i];
 
-                // Check if the new position is within bounds and not an obstacle
-                if (isValid(newX, newY) && !closedList[newX][newY] && grid[newX][newY] == 0)
+                // Check if the new position is within bounds, not an obstacle and not closed
+                // (closed nodes never improve, the heuristic being consistent)
+                if (!isValid(newX, newY) || grid.blocked(newX, newY) || closed.test(newX, newY))
                 {
-                    int newG = current.g + 1; // Assuming all movements cost 1
-                    int newH = heuristic(newX, newY, goalX, goalY);
+                    continue;
+                }
+                int newG = current.g + grid.cost(newX, newY);
 
-                    // If the node does not exist, create it
-                    if (!nodes[newX][newY])
-                    {
-                        nodes[newX][newY] = new Node(newX, newY, newG, newH, nodes[current.x][current.y]);
-                        openList.push(*nodes[newX][newY]);
-                    }
-                    else if (newG < nodes[newX][newY]->g)
+                // If the node does not exist, create it; otherwise keep the shorter path
+                Node *next;
+                if (!seen.test(newX, newY))
+                {
+                    next = newNode(newX, newY, newG, heuristic(newX, newY, goalX, goalY), &current);
+                }
+                else
+                {
+                    next = lookup(newX, newY);
+                    if (newG >= next->g)
                     {
-                        // Update node if a better path is found
-                        nodes[newX][newY]->g = newG;
-                        nodes[newX][newY]->f = newG + newH;
-                        nodes[newX][newY]->parent = nodes[current.x][current.y];
-                        openList.push(*nodes[newX][newY]);
+                        continue;
                     }
+                    next->g = newG;
+                    next->f = newG + next->h;
+                    next->parent = &current;
                 }
+                openList.push(next->id, next->f, next->h);
             }
         }
 
@@ -109,6 +389,110 @@ public:
         return nullptr;
     }
 
+    // Jump Point Search for maps without cell costs (falls back to findPath otherwise). Only
+    // jump points get node records: straight runs are skipped, and a horizontal run is scanned
+    // 64 cells at a time on the row bitmaps, skipping words the row summaries show to be far from
+    // any obstacle. Rows that neither hold nor touch an obstacle are passed by a count lookup, so
+    // open fields cost little more than the rows crossed. From a
+    // free start, path lengths equal findPath's; a blocked start has no path. The parent chain
+    // lists the jump points, joined by straight segments
+    Node *findPathJPS(pair<int, int> start, pair<int, int> goal)
+    {
+        if (!grid.uniformCost())
+        {
+            return findPath(start, goal);
+        }
+        goalX = goal.first, goalY = goal.second;
+        reset();
+        if (grid.blocked(start.first, start.second))
+        {
+            return nullptr;
+        }
+
+        Node *startNode = newNode(start.first, start.second, 0, heuristic(start.first, start.second, goalX, goalY), nullptr);
+        openList.push(startNode->id, startNode->f, startNode->h);
+
+        while (!openList.empty())
+        {
+            Node &current = node(openList.pop());
+            closed.set(current.x, current.y);
+            expanded++;
+
+            if (current.x == goalX && current.y == goalY)
+            {
+                return &current;
+            }
+
+            // A run keeps going straight and may turn either way; the start may go anywhere
+            for (int i = 0; i < 4; ++i)
+            {
+                if (current.parent)
+                {
+                    bool cameVertically = current.parent->y == current.y;
+                    bool goesVertically = dy[i] == 0;
+                    int back = cameVertically ? (current.parent->x < current.x ? -1 : 1) : (current.parent->y < current.y ? -1 : 1);
+                    if (cameVertically == goesVertically && (goesVertically ? dx[i] : dy[i]) == back)
+                    {
+                        continue; // never turn around
+                    }
+                }
+                int newX = current.x, newY = current.y;
+                if (dy[i] == 0)
+                {
+                    newX = jumpVertical(current.x + dx[i], current.y, dx[i]);
+                    if (newX == -1)
+                    {
+                        continue;
+                    }
+                }
+                else
+                {
+                    newY = jumpHorizontal(current.x, current.y + dy[i], dy[i]);
+                    if (newY == -1)
+                    {
+                        continue;
+                    }
+                }
+                if (closed.test(newX, newY))
+                {
+                    continue;
+                }
+
+                int newG = current.g + abs(newX - current.x) + abs(newY - current.y);
+                Node *next;
+                if (!seen.test(newX, newY))
+                {
+                    next = newNode(newX, newY, newG, heuristic(newX, newY, goalX, goalY), &current);
+                }
+                else
+                {
+                    next = lookup(newX, newY);
+                    if (newG >= next->g)
+                    {
+                        continue;
+                    }
+                    next->g = newG;
+                    next->f = newG + next->h;
+                    next->parent = &current;
+                }
+                openList.push(next->id, next->f, next->h);
+            }
+        }
+        return nullptr;
+    }
+
+    // Number of nodes taken off the open list by the last findPath call
+    int expandedNodes() const
+    {
+        return expanded;
+    }
+
+    // Node records the last findPath call created
+    int touchedNodes() const
+    {
+        return used;
+    }
+
     // Reconstruct the path by following parent nodes
     void reconstructPath(Node *goalNode)
     {
@@ -131,11 +515,11 @@ public:
     void printGrid()
     {
         cout << "Grid layout:\n";
-        for (int i = 0; i < rows; ++i)
+        for (int i = 0; i < grid.rows; ++i)
         {
-            for (int j = 0; j < cols; ++j)
+            for (int j = 0; j < grid.cols; ++j)
             {
-                if (grid[i][j] == 1)
+                if (grid.blocked(i, j))
                 {
                     cout << "X "; // Represents obstacle
                 }
@@ -149,38 +533,331 @@ public:
     }
 
 private:
-    int rows, cols;
-    int grid[MAX_SIZE][MAX_SIZE]; // Grid representation (1 for obstacle, 0 for free space)
+    static const int BLOCK = 4096; // nodes per arena block
+
+    const GridMap &grid;
+    CellBitmap seen;   // cells with a node record (open or closed)
+    CellBitmap closed; // cells already expanded
+    IndexedHeap openList;
+    vector<unique_ptr<Node[]>> blocks; // node arena; blocks are kept for the next query
+    int used = 0;
+    vector<int> tileOf;          // per 64x64 tile of the map: its block in tileNodes, or -1
+    vector<int> tileNodes;       // node id of every cell of the tiles in use (valid where seen is set)
+    vector<int> tilesInUse;
+    int tilesPerRow = 0, freeTile = 0;
+    int expanded = 0;
+
+    Node &node(int id)
+    {
+        return blocks[id / BLOCK][id % BLOCK];
+    }
+
+    // Forget the previous query: clear only the bits and tiles it used
+    void reset()
+    {
+        for (int id = 0; id < used; ++id)
+        {
+            Node &n = node(id);
+            seen.reset(n.x, n.y);
+            closed.reset(n.x, n.y);
+        }
+        for (int tile : tilesInUse)
+        {
+            tileOf[tile] = -1;
+        }
+        tilesInUse.clear();
+        freeTile = 0;
+        openList.clear();
+        used = 0;
+        expanded = 0;
+    }
+
+    Node *newNode(int x, int y, int g, int h, Node *parent)
+    {
+        if (used == (int)blocks.size() * BLOCK)
+        {
+            blocks.emplace_back(new Node[BLOCK]);
+        }
+        Node &n = node(used);
+        n = Node(x, y, g, h, parent);
+        n.id = used++;
+        seen.set(x, y);
+        cellSlot(x, y) = n.id;
+        return &n;
+    }
+
+    Node *lookup(int x, int y)
+    {
+        return &node(cellSlot(x, y));
+    }
+
+    // Node id slot of a cell; tiles get a block on first touch and give it back in reset()
+    int &cellSlot(int x, int y)
+    {
+        int tile = (x >> 6) * tilesPerRow + (y >> 6);
+        if (tileOf[tile] == -1)
+        {
+            if ((size_t)(freeTile + 1) * 4096 > tileNodes.size())
+            {
+                tileNodes.resize((size_t)(freeTile + 1) * 4096);
+            }
+            tileOf[tile] = freeTile++;
+            tilesInUse.push_back(tile);
+        }
+        return tileNodes[(size_t)tileOf[tile] * 4096 + (x & 63) * 64 + (y & 63)];
+    }
+
+    int goalX = 0, goalY = 0; // goal of the running findPathJPS
+
+    // First jump point on row x from column y on, moving by dir (+1 right, -1 left), or -1 if
+    // an obstacle or the edge comes first. A cell is a jump point if it is the goal or if the
+    // cell above or below it is free while the one before that (against dir) is blocked
+    int jumpHorizontal(int x, int y, int dir)
+    {
+        if (y < 0 || y >= grid.cols || openRow(x))
+        {
+            return -1;
+        }
+        int words = grid.rowWords();
+        const uint64_t *here = grid.row(x);
+        const uint64_t *above = x > 0 ? grid.row(x - 1) : nullptr;
+        const uint64_t *below = x + 1 < grid.rows ? grid.row(x + 1) : nullptr;
+        auto forced = [&](const uint64_t *side, int w) -> uint64_t
+        {
+            if (!side)
+            {
+                return 0; // off the map counts as blocked, and a blocked cell forces nothing
+            }
+            uint64_t cells = side[w];
+            uint64_t before; // blocked bit of each cell's predecessor along dir
+            if (dir > 0)
+            {
+                before = cells << 1 | (w > 0 ? side[w - 1] >> 63 : 1);
+            }
+            else
+            {
+                before = cells >> 1 | (w + 1 < words ? side[w + 1] << 63 : 1ULL << 63);
+            }
+            return ~cells & before;
+        };
+
+        // Only words with an obstacle on this row, on a row next to it or (for a blocked last cell
+        // forcing the first cell of the next word) just before that along dir can stop the run
+        int summaries = grid.summaryWords();
+        const uint64_t *busyHere = grid.rowSummary(x);
+        const uint64_t *busyAbove = above ? grid.rowSummary(x - 1) : nullptr;
+        const uint64_t *busyBelow = below ? grid.rowSummary(x + 1) : nullptr;
+        auto busySides = [&](int s) -> uint64_t
+        {
+            if (s < 0 || s >= summaries)
+            {
+                return 0;
+            }
+            return (busyAbove ? busyAbove[s] : 0) | (busyBelow ? busyBelow[s] : 0);
+        };
+        auto nextWord = [&](int w) -> int
+        {
+            for (int s = w >> 6; s >= 0 && s < summaries; s += dir)
+            {
+                uint64_t sides = busySides(s);
+                uint64_t candidates = busyHere[s] | sides;
+                candidates |= dir > 0 ? sides << 1 | busySides(s - 1) >> 63 : sides >> 1 | busySides(s + 1) << 63;
+                if (x == goalX && goalY / 4096 == s)
+                {
+                    candidates |= 1ULL << (goalY / 64 % 64);
+                }
+                if (s == w >> 6)
+                {
+                    candidates &= dir > 0 ? ~0ULL << (w & 63) : ~0ULL >> (63 - (w & 63));
+                }
+                if (candidates)
+                {
+                    return s * 64 + (dir > 0 ? __builtin_ctzll(candidates) : 63 - __builtin_clzll(candidates));
+                }
+            }
+            return -1;
+        };
+
+        for (int w = y / 64; w >= 0 && w < words; w = nextWord(w + dir))
+        {
+            uint64_t range = ~0ULL;
+            if (w == y / 64)
+            {
+                range = dir > 0 ? ~0ULL << (y % 64) : ~0ULL >> (63 - y % 64);
+            }
+            uint64_t stop = here[w] & range;
+            uint64_t hit = (forced(above, w) | forced(below, w)) & range;
+            if (x == goalX && goalY / 64 == w)
+            {
+                hit |= 1ULL << (goalY % 64) & range;
+            }
+            if (!(stop | hit))
+            {
+                continue;
+            }
+            int stopBit = stop ? (dir > 0 ? __builtin_ctzll(stop) : 63 - __builtin_clzll(stop)) : -1;
+            int hitBit = hit ? (dir > 0 ? __builtin_ctzll(hit) : 63 - __builtin_clzll(hit)) : -1;
+            if (hitBit == -1 || (stopBit != -1 && (dir > 0 ? stopBit <= hitBit : stopBit >= hitBit)))
+            {
+                return -1;
+            }
+            return w * 64 + hitBit;
+        }
+        return -1;
+    }
+
+    // First jump point in column y from row x on, moving by dir (+1 down, -1 up), or -1. Besides
+    // the goal and forced neighbours, a cell is a jump point if a horizontal jump from it finds one
+    int jumpVertical(int x, int y, int dir)
+    {
+        for (; x >= 0 && x < grid.rows; x += dir)
+        {
+            if (openRow(x))
+            {
+                continue; // No jump point and nothing to scan on an open row
+            }
+            if (grid.blocked(x, y))
+            {
+                return -1;
+            }
+            if (x == goalX && y == goalY)
+            {
+                return x;
+            }
+            bool leftForced = y > 0 && !grid.blocked(x, y - 1) && grid.blocked(x - dir, y - 1);
+            bool rightForced = y + 1 < grid.cols && !grid.blocked(x, y + 1) && grid.blocked(x - dir, y + 1);
+            if (leftForced || rightForced || jumpHorizontal(x, y + 1, 1) != -1 || jumpHorizontal(x, y - 1, -1) != -1)
+            {
+                return x;
+            }
+        }
+        return -1;
+    }
 
-    // Heuristic function (Manhattan Distance)
+    // Row x and both rows next to it are free of obstacles and x is not the goal row: then no cell
+    // of row x is blocked, forced or the goal, so no jump point can lie on it
+    bool openRow(int x) const
+    {
+        return x != goalX && grid.rowClear(x - 1) && grid.rowClear(x) && grid.rowClear(x + 1);
+    }
+
+    // Heuristic function (Manhattan Distance times the cheapest cell cost)
     int heuristic(int x1, int y1, int x2, int y2)
     {
-        return abs(x1 - x2) + abs(y1 - y2);
+        return (abs(x1 - x2) + abs(y1 - y2)) * grid.minCost();
     }
 
     // Check if a position is within bounds of the grid
     bool isValid(int x, int y)
     {
-        return x >= 0 && x < rows && y >= 0 && y < cols;
+        return x >= 0 && x < grid.rows && y >= 0 && y < grid.cols;
     }
 };
 
-int main()
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name: Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
     cout << "\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        // "16 bench <size>": random start / goal pairs up to 1000 cells apart on three size x size
+        // maps, a warehouse (2 x 20 shelves separated by one-cell aisles), an open floor plan
+        // (rooms of 100 x 100 with doors, 1% clutter) and an open field without any obstacle,
+        // with plain A* and with Jump Point Search
+        int size = argc > 2 ? atoi(argv[2]) : 10000;
+        GridMap warehouse(size, size), floorPlan(size, size), openField(size, size);
+        unsigned seed = 3;
+        for (int i = 0; i < size; ++i)
+        {
+            for (int j = 0; j < size; ++j)
+            {
+                warehouse.setBlocked(i, j, i % 3 != 0 && j % 21 != 0);
+                seed = seed * 1103515245u + 12345u;
+                bool wall = (i % 100 == 0 && j % 50 != 25) || (j % 100 == 0 && i % 50 != 25);
+                floorPlan.setBlocked(i, j, wall || (seed >> 8) % 100 == 0);
+            }
+        }
+
+        for (const GridMap *map : {&warehouse, &floorPlan, &openField})
+        {
+            AStar planner(*map);
+            int queries = 100, reach = min(size, 1000);
+            cout << (map == &warehouse ? "Warehouse " : map == &floorPlan ? "Floor plan " : "Open field ") << size << "x"
+                 << size << ", "
+                 << map->memoryBytes() / 1048576.0 << " MB" << endl;
+            double astarMs = 0;
+            long long astarLength = 0;
+            for (bool jps : {false, true})
+            {
+                unsigned querySeed = 11;
+                int found = 0;
+                long long expanded = 0, touched = 0, length = 0;
+                auto begin = chrono::steady_clock::now();
+                for (int q = 0; q < queries; ++q)
+                {
+                    int sx, sy, gx, gy;
+                    do
+                    {
+                        querySeed = querySeed * 1103515245u + 12345u;
+                        sx = (querySeed >> 8) % size;
+                        querySeed = querySeed * 1103515245u + 12345u;
+                        sy = (querySeed >> 8) % size;
+                        querySeed = querySeed * 1103515245u + 12345u;
+                        gx = min(size - 1, max(0, sx + (int)((querySeed >> 8) % reach) - reach / 2));
+                        querySeed = querySeed * 1103515245u + 12345u;
+                        gy = min(size - 1, max(0, sy + (int)((querySeed >> 8) % reach) - reach / 2));
+                    } while (map->blocked(sx, sy) || map->blocked(gx, gy));
+                    Node *goalNode = jps ? planner.findPathJPS({sx, sy}, {gx, gy}) : planner.findPath({sx, sy}, {gx, gy});
+                    if (goalNode)
+                    {
+                        found++;
+                        length += goalNode->g;
+                    }
+                    expanded += planner.expandedNodes();
+                    touched += planner.touchedNodes();
+                }
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+                cout << (jps ? "  Jump Point Search: " : "  A*: ") << ms * 1000 / queries << " us per query, " << found
+                     << " paths, total length " << length << ", " << expanded / queries << " nodes expanded, "
+                     << touched / queries << " node records on average" << endl;
+                if (!jps)
+                {
+                    astarMs = ms, astarLength = length;
+                }
+                else if (length != astarLength)
+                {
+                    cout << "  MISMATCH: Jump Point Search paths differ from A*" << endl;
+                    return 1;
+                }
+                else
+                {
+                    cout << "  Jump Point Search is " << astarMs / ms << "x as fast as A*" << endl;
+                }
+            }
+        }
+        return 0;
+    }
+
     // Grid representing the game environment (0 = free, 1 = obstacle)
-    int grid[MAX_SIZE][MAX_SIZE] = {
+    int cells[5][5] = {
         {0, 0, 1, 0, 0},
         {0, 1, 1, 0, 0},
         {0, 0, 0, 0, 0},
         {0, 1, 1, 0, 1},
         {0, 0, 0, 0, 0}};
+    GridMap grid(5, 5);
+    for (int i = 0; i < 5; ++i)
+    {
+        for (int j = 0; j < 5; ++j)
+        {
+            grid.setBlocked(i, j, cells[i][j] == 1);
+        }
+    }
 
     // Create A* instance with the grid
-    AStar astar(5, 5, grid);
+    AStar astar(grid);
 
     // Print the grid layout before running the algorithm
     astar.printGrid();
@@ -194,6 +871,11 @@ int main()
 
     // Output the path
     astar.reconstructPath(goalNode);
+
+    // Same query with Jump Point Search: only the turning points are listed
+    cout << "Jump points:\n";
+    astar.reconstructPath(astar.findPathJPS(start, goal));
+    cout << flush;
     system("pause");
     return 0;
 }
@@ -1,5 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <string>
 using namespace std;
 
 // Function to display the graph as an adjacency list
@@ -17,32 +23,683 @@ void displayGraph(const vector<vector<int>> &graph)
     }
 }
 
-// Function to detect a cycle in a directed graph using DFS
-bool dfsDirected(int node, vector<vector<int>> &graph, vector<int> &visited)
+// Strongly connected components of a directed graph. Component ids run from 0 to count - 1;
+// dag is the condensation (one edge list per component, no duplicates or self-loops)
+struct SCCResult
 {
-    if (visited[node] == 1)
-    { // Node is in the current recursion stack, cycle detected
-        return true;
+    vector<int> component;
+    int count = 0;
+    vector<vector<int>> dag;
+};
+
+// Build the condensation DAG of graph for a given component labelling
+void buildCondensation(const vector<vector<int>> &graph, SCCResult &result)
+{
+    result.dag.assign(result.count, {});
+    vector<int> lastSeen(result.count, -1);
+
+    // Vertices grouped by component (counting sort)
+    vector<int> first(result.count + 1, 0), members(graph.size());
+    for (int c : result.component)
+    {
+        first[c + 1]++;
     }
-    if (visited[node] == 2)
-    { // Node has already been completely processed
-        return false;
+    for (int c = 0; c < result.count; ++c)
+    {
+        first[c + 1] += first[c];
+    }
+    vector<int> slot(first.begin(), first.end() - 1);
+    for (int v = 0; v < (int)graph.size(); ++v)
+    {
+        members[slot[result.component[v]]++] = v;
     }
 
-    // Mark the node as being visited (currently in the recursion stack)
-    visited[node] = 1;
+    for (int c = 0; c < result.count; ++c)
+    {
+        for (int i = first[c]; i < first[c + 1]; ++i)
+        {
+            int v = members[i];
+            for (int w : graph[v])
+            {
+                int d = result.component[w];
+                if (d != c && lastSeen[d] != c)
+                {
+                    lastSeen[d] = c;
+                    result.dag[c].push_back(d);
+                }
+            }
+        }
+    }
+}
 
-    // Explore all the neighbors of the current node
-    for (int neighbor : graph[node])
+// One iterative Tarjan search from root, using explicit stacks so deep graphs cannot overflow
+// the call stack. Vertices whose component is already set are treated as removed. Each SCC is
+// labelled with newComponent(v), v being the first vertex of the SCC the search reached.
+// Searches over disjoint vertex sets may share the per-vertex arrays
+template <class NewComponent>
+void tarjanSearch(int root, const vector<vector<int>> &graph, vector<int> &component, vector<int> &index,
+                  vector<int> &low, NewComponent newComponent)
+{
+    vector<int> sccStack;
+    vector<pair<int, int>> callStack; // (vertex, next edge to look at)
+    int counter = 0;
+    callStack.push_back({root, 0});
+    index[root] = low[root] = counter++;
+    sccStack.push_back(root);
+    while (!callStack.empty())
     {
-        if (dfsDirected(neighbor, graph, visited))
+        int v = callStack.back().first;
+        int &next = callStack.back().second;
+        if (next < (int)graph[v].size())
         {
+            int w = graph[v][next++];
+            if (component[w] != -1)
+            {
+                continue; // finished, or removed before this search
+            }
+            if (index[w] == -1)
+            {
+                index[w] = low[w] = counter++;
+                sccStack.push_back(w);
+                callStack.push_back({w, 0});
+            }
+            else
+            {
+                low[v] = min(low[v], index[w]); // w is still on the SCC stack
+            }
+            continue;
+        }
+
+        callStack.pop_back();
+        if (!callStack.empty())
+        {
+            int parent = callStack.back().first;
+            low[parent] = min(low[parent], low[v]);
+        }
+        if (low[v] == index[v])
+        {
+            int id = newComponent(v), w;
+            do
+            {
+                w = sccStack.back();
+                sccStack.pop_back();
+                component[w] = id;
+            } while (w != v);
+        }
+    }
+}
+
+// Tarjan's algorithm over the whole graph. Components are numbered in topological order of
+// the condensation (sources first)
+SCCResult findStronglyConnectedComponents(const vector<vector<int>> &graph)
+{
+    int n = graph.size();
+    SCCResult result;
+    result.component.assign(n, -1);
+    vector<int> index(n, -1), low(n);
+    for (int root = 0; root < n; ++root)
+    {
+        if (index[root] == -1)
+        {
+            tarjanSearch(root, graph, result.component, index, low, [&](int)
+                         { return result.count++; });
+        }
+    }
+
+    // Tarjan finds sinks first; flip the ids so edges go from lower to higher components
+    for (int &c : result.component)
+    {
+        c = result.count - 1 - c;
+    }
+    buildCondensation(graph, result);
+    return result;
+}
+
+// Run body(thread, from, to) over [0, count) split into one contiguous range per thread
+void parallelRanges(size_t count, int numThreads, const function<void(int, size_t, size_t)> &body)
+{
+    int workers = (int)min<size_t>(numThreads, (count + 1023) / 1024); // small ranges stay on one thread
+    if (workers <= 1)
+    {
+        body(0, 0, count);
+        return;
+    }
+    vector<thread> threads;
+    for (int t = 0; t < workers; ++t)
+    {
+        threads.emplace_back(body, t, count * t / workers, count * (t + 1) / workers);
+    }
+    for (thread &th : threads)
+    {
+        th.join();
+    }
+}
+
+// Process a worklist until it is empty; process(v, push) may add vertices to push. Large
+// frontiers are processed in synchronous rounds across threads, small ones on this thread
+void drainWorklist(vector<int> frontier, int numThreads, const function<void(int, vector<int> &)> &process)
+{
+    const size_t parallelSize = 4096;
+    vector<vector<int>> pushed(numThreads);
+    while (!frontier.empty())
+    {
+        if (numThreads == 1 || frontier.size() < parallelSize)
+        {
+            // Depth-first on the calling thread until done or the worklist grows large again
+            while (!frontier.empty() && (numThreads == 1 || frontier.size() < 4 * parallelSize))
+            {
+                int v = frontier.back();
+                frontier.pop_back();
+                process(v, frontier);
+            }
+            continue;
+        }
+        parallelRanges(frontier.size(), numThreads, [&](int t, size_t from, size_t to)
+                       {
+                           pushed[t].clear();
+                           for (size_t i = from; i < to; ++i)
+                               process(frontier[i], pushed[t]); });
+        frontier.clear();
+        for (auto &part : pushed)
+        {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+            part.clear();
+        }
+    }
+}
+
+// Parallel SCC for large graphs: trim vertices without active in- or out-edges, peel the
+// giant component with one forward-backward search from a high-degree pivot, then run
+// sequential Tarjan searches on the remaining weakly connected pieces in parallel. (Colouring
+// rounds for the remainder were tried; on layered dependency graphs they need thousands of
+// rounds.)
+SCCResult parallelStronglyConnectedComponents(const vector<vector<int>> &graph, int numThreads = 0)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = max(1u, thread::hardware_concurrency());
+    }
+    int n = graph.size();
+
+    // Reverse adjacency in CSR form
+    vector<int> revFirst(n + 1, 0), revTarget;
+    for (int v = 0; v < n; ++v)
+    {
+        for (int w : graph[v])
+        {
+            revFirst[w + 1]++;
+        }
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        revFirst[v + 1] += revFirst[v];
+    }
+    revTarget.resize(revFirst[n]);
+    {
+        vector<int> slot(revFirst.begin(), revFirst.end() - 1);
+        for (int v = 0; v < n; ++v)
+        {
+            for (int w : graph[v])
+            {
+                revTarget[slot[w]++] = v;
+            }
+        }
+    }
+
+    vector<atomic<int>> comp(n);  // representative vertex once assigned, -1 while active
+    vector<atomic<int>> inDeg(n), outDeg(n);
+    vector<atomic<char>> mark(n); // forward / backward reach bits of the pivot search
+    parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                   {
+                       for (size_t v = from; v < to; ++v)
+                       {
+                           comp[v].store(-1, memory_order_relaxed);
+                           inDeg[v].store(revFirst[v + 1] - revFirst[v], memory_order_relaxed);
+                           outDeg[v].store(graph[v].size(), memory_order_relaxed);
+                           mark[v].store(0, memory_order_relaxed);
+                       } });
+
+    // Trim: a vertex with no active in- or out-edges is a component by itself
+    auto trim = [&](const vector<int> &candidates)
+    {
+        drainWorklist(candidates, numThreads, [&](int v, vector<int> &push)
+                      {
+                          int expected = -1;
+                          if (!comp[v].compare_exchange_strong(expected, v))
+                              return;
+                          for (int w : graph[v])
+                              if (inDeg[w].fetch_sub(1) == 1 && comp[w].load() == -1)
+                                  push.push_back(w);
+                          for (int i = revFirst[v]; i < revFirst[v + 1]; ++i)
+                          {
+                              int w = revTarget[i];
+                              if (outDeg[w].fetch_sub(1) == 1 && comp[w].load() == -1)
+                                  push.push_back(w);
+                          } });
+    };
+    vector<int> candidates;
+    for (int v = 0; v < n; ++v)
+    {
+        if (inDeg[v] == 0 || outDeg[v] == 0)
+        {
+            candidates.push_back(v);
+        }
+    }
+    trim(candidates);
+
+    // Forward-backward from the pivot with the most remaining in * out edges
+    int pivot = -1;
+    long long best = -1;
+    for (int v = 0; v < n; ++v)
+    {
+        if (comp[v] == -1 && (long long)inDeg[v] * outDeg[v] > best)
+        {
+            best = (long long)inDeg[v] * outDeg[v];
+            pivot = v;
+        }
+    }
+    if (pivot != -1)
+    {
+        for (int direction = 1; direction <= 2; direction <<= 1)
+        {
+            mark[pivot] |= direction;
+            drainWorklist({pivot}, numThreads, [&](int v, vector<int> &push)
+                          {
+                              auto visit = [&](int w)
+                              {
+                                  if (comp[w].load(memory_order_relaxed) == -1 && !(mark[w].fetch_or(direction) & direction))
+                                      push.push_back(w);
+                              };
+                              if (direction == 1)
+                                  for (int w : graph[v])
+                                      visit(w);
+                              else
+                                  for (int i = revFirst[v]; i < revFirst[v + 1]; ++i)
+                                      visit(revTarget[i]);
+                          });
+        }
+        parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                       {
+                           for (size_t v = from; v < to; ++v)
+                               if (mark[v].load(memory_order_relaxed) == 3)
+                                   comp[v].store(pivot, memory_order_relaxed); });
+    }
+
+    // The rest falls apart into weakly connected pieces (lock-free union-find over the
+    // remaining edges); each piece is finished by a sequential Tarjan search on some thread
+    vector<atomic<int>> &parent = inDeg; // degrees are no longer needed
+    parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                   {
+                       for (size_t v = from; v < to; ++v)
+                           parent[v].store(v, memory_order_relaxed); });
+    auto findRoot = [&](int x)
+    {
+        while (true)
+        {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x)
+                return x;
+            int grandparent = parent[p].load(memory_order_relaxed);
+            if (p != grandparent)
+                parent[x].compare_exchange_weak(p, grandparent, memory_order_relaxed);
+            x = grandparent;
+        }
+    };
+    parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                   {
+                       for (size_t v = from; v < to; ++v)
+                       {
+                           if (comp[v].load(memory_order_relaxed) != -1)
+                               continue;
+                           for (int w : graph[v])
+                           {
+                               if (comp[w].load(memory_order_relaxed) != -1)
+                                   continue;
+                               int a = v, b = w;
+                               while (true)
+                               {
+                                   a = findRoot(a), b = findRoot(b);
+                                   if (a == b)
+                                       break;
+                                   if (a < b)
+                                       swap(a, b);
+                                   int expected = a;
+                                   if (parent[a].compare_exchange_strong(expected, b, memory_order_relaxed))
+                                       break;
+                               }
+                           }
+                       } });
+
+    vector<int> label(n), pieceFirst(n + 1, 0), pieceVertices;
+    for (int v = 0; v < n; ++v)
+    {
+        label[v] = comp[v];
+        if (label[v] == -1)
+        {
+            pieceFirst[findRoot(v) + 1]++;
+        }
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        pieceFirst[v + 1] += pieceFirst[v];
+    }
+    pieceVertices.resize(pieceFirst[n]);
+    {
+        vector<int> slot(pieceFirst.begin(), pieceFirst.end() - 1);
+        for (int v = 0; v < n; ++v)
+        {
+            if (label[v] == -1)
+            {
+                pieceVertices[slot[findRoot(v)]++] = v;
+            }
+        }
+    }
+    vector<int> pieces;
+    for (int v = 0; v < n; ++v)
+    {
+        if (pieceFirst[v + 1] > pieceFirst[v])
+        {
+            pieces.push_back(v);
+        }
+    }
+    sort(pieces.begin(), pieces.end(), [&](int a, int b)
+         { return pieceFirst[a + 1] - pieceFirst[a] > pieceFirst[b + 1] - pieceFirst[b]; }); // largest first
+
+    vector<int> index(n, -1), low(n);
+    atomic<size_t> nextPiece(0);
+    vector<thread> workers;
+    for (int t = 0; t < min<int>(numThreads, pieces.size()); ++t)
+    {
+        workers.emplace_back([&]()
+                             {
+                                 for (size_t p; (p = nextPiece.fetch_add(1)) < pieces.size();)
+                                 {
+                                     int piece = pieces[p];
+                                     for (int i = pieceFirst[piece]; i < pieceFirst[piece + 1]; ++i)
+                                         if (index[pieceVertices[i]] == -1)
+                                             tarjanSearch(pieceVertices[i], graph, label, index, low, [](int v)
+                                                          { return v; });
+                                 } });
+    }
+    for (thread &th : workers)
+    {
+        th.join();
+    }
+
+    // Number the components by their representatives
+    SCCResult result;
+    result.component.assign(n, -1);
+    vector<int> id(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        int rep = label[v];
+        if (id[rep] == -1)
+        {
+            id[rep] = result.count++;
+        }
+        result.component[v] = id[rep];
+    }
+    buildCondensation(graph, result);
+    return result;
+}
+
+// Result of a topological sort. level[v] is the length of the longest path into v, so all
+// vertices of one level are independent; order lists the levels one after another. If the
+// graph has a cycle, acyclic is false, order / level cover only the sortable part (level -1
+// elsewhere) and cycle holds one concrete cycle (v0 -> v1 -> ... -> v0, first vertex not repeated)
+struct TopologicalOrder
+{
+    vector<int> order;
+    vector<int> level;
+    vector<int> cycle;
+    bool acyclic = true;
+};
+
+// Kahn's algorithm level by level: the ready vertices of a level are split across threads,
+// each thread decrements in-degrees atomically and collects the vertices that drop to zero in
+// its own ready queue, and the queues together form the next level
+TopologicalOrder parallelTopologicalSort(const vector<vector<int>> &graph, int numThreads = 0)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = max(1u, thread::hardware_concurrency());
+    }
+    int n = graph.size();
+    TopologicalOrder result;
+    result.level.assign(n, -1);
+    result.order.reserve(n);
+
+    vector<atomic<int>> inDegree(n);
+    parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                   {
+                       for (size_t v = from; v < to; ++v)
+                           inDegree[v].store(0, memory_order_relaxed); });
+    parallelRanges(n, numThreads, [&](int, size_t from, size_t to)
+                   {
+                       for (size_t v = from; v < to; ++v)
+                           for (int w : graph[v])
+                               inDegree[w].fetch_add(1, memory_order_relaxed); });
+    for (int v = 0; v < n; ++v)
+    {
+        if (inDegree[v].load(memory_order_relaxed) == 0)
+        {
+            result.order.push_back(v);
+        }
+    }
+
+    vector<vector<int>> ready(numThreads);
+    size_t levelBegin = 0;
+    for (int depth = 0; levelBegin < result.order.size(); ++depth)
+    {
+        size_t levelEnd = result.order.size();
+        parallelRanges(levelEnd - levelBegin, numThreads, [&](int t, size_t from, size_t to)
+                       {
+                           for (size_t i = levelBegin + from; i < levelBegin + to; ++i)
+                           {
+                               int v = result.order[i];
+                               result.level[v] = depth;
+                               for (int w : graph[v])
+                                   if (inDegree[w].fetch_sub(1, memory_order_relaxed) == 1)
+                                       ready[t].push_back(w);
+                           } });
+        for (auto &queue : ready)
+        {
+            result.order.insert(result.order.end(), queue.begin(), queue.end());
+            queue.clear();
+        }
+        levelBegin = levelEnd;
+    }
+    if ((int)result.order.size() == n)
+    {
+        return result;
+    }
+
+    // Every vertex left over still has a predecessor that is left over, so walking
+    // predecessors from any of them must run into a cycle
+    result.acyclic = false;
+    vector<int> predecessor(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        if (result.level[v] == -1)
+        {
+            for (int w : graph[v])
+            {
+                if (result.level[w] == -1)
+                {
+                    predecessor[w] = v;
+                }
+            }
+        }
+    }
+    int v = 0;
+    while (result.level[v] != -1)
+    {
+        v++;
+    }
+    vector<char> seen(n, 0);
+    while (!seen[v])
+    {
+        seen[v] = 1;
+        v = predecessor[v];
+    }
+    for (int u = v;;)
+    {
+        result.cycle.push_back(u);
+        u = predecessor[u];
+        if (u == v)
+        {
+            break;
+        }
+    }
+    reverse(result.cycle.begin(), result.cycle.end());
+    return result;
+}
+
+// Online cycle prevention (Pearce-Kelly): keeps a topological order of a DAG while edges
+// arrive one at a time. An edge that already agrees with the order is just added. Otherwise
+// only the vertices whose positions lie between the two endpoints are searched: forward from
+// the head (a hit on the tail means a cycle, so the edge is rejected) and backward from the
+// tail, and the two sets swap places within the positions they already occupy
+class IncrementalTopologicalOrder
+{
+public:
+    IncrementalTopologicalOrder(int nodes) : out(nodes), in(nodes), position(nodes), vertexAt(nodes), visitedStamp(nodes, 0)
+    {
+        for (int v = 0; v < nodes; ++v)
+        {
+            position[v] = vertexAt[v] = v;
+        }
+    }
+
+    // Add the edge u -> v unless it would close a cycle; returns whether it was added
+    bool addEdge(int u, int v)
+    {
+        if (u == v)
+        {
+            return false;
+        }
+        int lower = position[v], upper = position[u];
+        if (lower > upper)
+        {
+            out[u].push_back(v);
+            in[v].push_back(u);
             return true;
         }
+
+        ++stamp;
+        forward.clear();
+        if (!search(v, out, forward, upper, true))
+        {
+            return false;
+        }
+        backward.clear();
+        search(u, in, backward, lower, false);
+        reorder();
+        out[u].push_back(v);
+        in[v].push_back(u);
+        return true;
+    }
+
+    // Position of v in the current topological order
+    int rank(int v) const
+    {
+        return position[v];
+    }
+
+    const vector<int> &order() const
+    {
+        return vertexAt;
+    }
+
+    long long verticesMoved = 0; // total size of all reordered regions
+
+private:
+    vector<vector<int>> out, in;
+    vector<int> position, vertexAt;
+    vector<int> visitedStamp;
+    vector<int> forward, backward, stack, slots;
+    int stamp = 0;
+
+    // Collect the vertices reachable from start (over edges) whose positions stay within the
+    // bound (<= bound going forward, >= bound going backward). Returns false if going forward
+    // hits the vertex at position bound, i.e. the new edge would close a cycle
+    bool search(int start, const vector<vector<int>> &edges, vector<int> &found, int bound, bool isForward)
+    {
+        visitedStamp[start] = stamp;
+        stack.assign(1, start);
+        while (!stack.empty())
+        {
+            int x = stack.back();
+            stack.pop_back();
+            found.push_back(x);
+            for (int y : edges[x])
+            {
+                if (isForward && position[y] == bound)
+                {
+                    return false;
+                }
+                bool inside = isForward ? position[y] < bound : position[y] > bound;
+                if (inside && visitedStamp[y] != stamp)
+                {
+                    visitedStamp[y] = stamp;
+                    stack.push_back(y);
+                }
+            }
+        }
+        return true;
     }
 
-    // Mark the node as completely processed
-    visited[node] = 2;
+    // Put the backward set first and the forward set after it, each keeping its relative order,
+    // in the sorted positions the two sets occupied together
+    void reorder()
+    {
+        auto byPosition = [&](int a, int b)
+        {
+            return position[a] < position[b];
+        };
+        sort(forward.begin(), forward.end(), byPosition);
+        sort(backward.begin(), backward.end(), byPosition);
+        slots.clear();
+        for (int x : backward)
+        {
+            slots.push_back(position[x]);
+        }
+        for (int x : forward)
+        {
+            slots.push_back(position[x]);
+        }
+        sort(slots.begin(), slots.end());
+        size_t i = 0;
+        for (const vector<int> *part : {&backward, &forward})
+        {
+            for (int x : *part)
+            {
+                position[x] = slots[i++];
+                vertexAt[position[x]] = x;
+            }
+        }
+        verticesMoved += slots.size();
+    }
+};
+
+// A directed graph has a cycle iff some SCC has more than one vertex or a vertex has a self-loop
+bool hasDirectedCycle(const vector<vector<int>> &graph)
+{
+    SCCResult scc = findStronglyConnectedComponents(graph);
+    if (scc.count < (int)graph.size())
+    {
+        return true;
+    }
+    for (int v = 0; v < (int)graph.size(); ++v)
+    {
+        for (int w : graph[v])
+        {
+            if (w == v)
+            {
+                return true;
+            }
+        }
+    }
     return false;
 }
 
@@ -75,26 +732,21 @@ bool dfsUndirected(int node, vector<vector<int>> &graph, vector<int> &visited, i
 // Function to detect cycle in a graph
 bool detectCycleInGraph(int nodes, vector<vector<int>> &graph, bool isDirected)
 {
-    vector<int> visited(nodes, 0); // 0 = Unvisited, 1 = Visiting, 2 = Visited
+    if (isDirected)
+    {
+        return hasDirectedCycle(graph);
+    }
+
+    vector<int> visited(nodes, 0); // 0 = Unvisited, 1 = Visited
 
     // DFS traversal for cycle detection
     for (int i = 0; i < nodes; ++i)
     {
         if (visited[i] == 0)
         {
-            if (isDirected)
+            if (dfsUndirected(i, graph, visited, -1))
             {
-                if (dfsDirected(i, graph, visited))
-                {
-                    return true;
-                }
-            }
-            else
-            {
-                if (dfsUndirected(i, graph, visited, -1))
-                {
-                    return true;
-                }
+                return true;
             }
         }
     }
@@ -102,11 +754,148 @@ bool detectCycleInGraph(int nodes, vector<vector<int>> &graph, bool isDirected)
     return false;
 }
 
-int main()
+// Random dependency-like graph: most edges point to higher ids, a few point anywhere and close cycles
+vector<vector<int>> randomDirectedGraph(int nodes, int edgesPerNode, double backEdgeShare, unsigned seed)
+{
+    vector<vector<int>> graph(nodes);
+    for (int v = 0; v < nodes; ++v)
+    {
+        for (int i = 0; i < edgesPerNode; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            bool back = (seed >> 8) % 1000000 < backEdgeShare * 1000000;
+            seed = seed * 1103515245u + 12345u;
+            int w = back ? (seed >> 8) % nodes : v + 1 + (seed >> 8) % 1000;
+            if (w < nodes)
+            {
+                graph[v].push_back(w);
+            }
+        }
+    }
+    return graph;
+}
+
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        // "4 bench <nodes>": SCCs of a random graph and of one long cycle
+        int n = argc > 2 ? atoi(argv[2]) : 2000000;
+        vector<vector<int>> random = randomDirectedGraph(n, 5, 0.01, 17);
+        vector<vector<int>> ring(n);
+        for (int v = 0; v < n; ++v)
+        {
+            ring[v].push_back((v + 1) % n);
+        }
+        int maxThreads = max(1u, thread::hardware_concurrency());
+        for (auto *graph : {&random, &ring})
+        {
+            cout << (graph == &ring ? "Ring" : "Random graph") << " with " << n << " nodes" << endl;
+            auto begin = chrono::steady_clock::now();
+            SCCResult scc = findStronglyConnectedComponents(*graph);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            cout << "Iterative Tarjan: " << ms << " ms, " << scc.count << " components" << endl;
+            for (int threads = 1; threads <= maxThreads; threads *= 2)
+            {
+                begin = chrono::steady_clock::now();
+                scc = parallelStronglyConnectedComponents(*graph, threads);
+                ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+                cout << "Forward-backward + Tarjan pieces, " << threads << " threads: " << ms << " ms, " << scc.count << " components" << endl;
+            }
+        }
+
+        // Topological sort and levels of a DAG with the same shape
+        vector<vector<int>> dag = randomDirectedGraph(n, 5, 0, 17);
+        cout << "DAG with " << n << " nodes" << endl;
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            auto begin = chrono::steady_clock::now();
+            TopologicalOrder topo = parallelTopologicalSort(dag, threads);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            cout << "Parallel Kahn, " << threads << " threads: " << ms << " ms, "
+                 << *max_element(topo.level.begin(), topo.level.end()) + 1 << " levels" << endl;
+        }
+
+        // Online insertion: edges of a sparse DAG arrive in random order. Vertex ids follow the
+        // DAG's order up to a shuffle inside windows of the given size, which sets how far
+        // apart the endpoints of an out-of-order edge are. Random edges follow; those that would
+        // close a cycle are rejected. One full cycle check is timed for comparison
+        auto onlineBench = [&](int nodes, int window)
+        {
+            vector<vector<int>> base = randomDirectedGraph(nodes, 3, 0, 23);
+            vector<int> id(nodes);
+            unsigned seed = 5;
+            for (int v = 0; v < nodes; ++v)
+            {
+                id[v] = v;
+            }
+            for (int from = 0; from < nodes; from += window)
+            {
+                int to = min(nodes, from + window);
+                for (int v = to - 1; v > from; --v)
+                {
+                    seed = seed * 1103515245u + 12345u;
+                    swap(id[v], id[from + (seed >> 8) % (v - from + 1)]);
+                }
+            }
+            vector<pair<int, int>> arrivals;
+            vector<vector<int>> accepted(nodes); // same graph for the full check at the end
+            for (int v = 0; v < nodes; ++v)
+            {
+                for (int w : base[v])
+                {
+                    arrivals.push_back({id[v], id[w]});
+                    accepted[id[v]].push_back(id[w]);
+                }
+            }
+            for (size_t i = arrivals.size() - 1; i > 0; --i)
+            {
+                seed = seed * 1103515245u + 12345u;
+                swap(arrivals[i], arrivals[(seed >> 8) % (i + 1)]);
+            }
+
+            IncrementalTopologicalOrder online(nodes);
+            auto begin = chrono::steady_clock::now();
+            for (auto &edge : arrivals)
+            {
+                online.addEdge(edge.first, edge.second);
+            }
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            cout << "Pearce-Kelly, " << nodes << " nodes, window " << window << ": " << ms * 1e6 / arrivals.size()
+                 << " ns per DAG edge, " << (double)online.verticesMoved / arrivals.size() << " vertices moved per edge";
+
+            int rejected = 0, extra = 1000;
+            begin = chrono::steady_clock::now();
+            for (int i = 0; i < extra; ++i)
+            {
+                seed = seed * 1103515245u + 12345u;
+                int u = (seed >> 8) % nodes;
+                seed = seed * 1103515245u + 12345u;
+                int v = (seed >> 8) % nodes;
+                if (!online.addEdge(u, v))
+                {
+                    rejected++;
+                }
+                else
+                {
+                    accepted[u].push_back(v);
+                }
+            }
+            ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            cout << ", " << ms * 1e6 / extra << " ns per random edge (" << rejected << " rejected)";
+
+            begin = chrono::steady_clock::now();
+            hasDirectedCycle(accepted);
+            cout << "; one full cycle check: " << chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count() << " ms" << endl;
+        };
+        onlineBench(n, 64);
+        onlineBench(20000, 20000);
+        return 0;
+    }
+
     // Number of nodes in the graph
     int nodes = 4;
 
@@ -143,6 +932,38 @@ int main()
         cout << "\nNo cycle detected in the directed graph." << endl;
     }
 
+    // Strongly connected components of the directed graph and their condensation
+    SCCResult scc = findStronglyConnectedComponents(directedGraph);
+    cout << "\n" << scc.count << " strongly connected components:\n";
+    for (int v = 0; v < nodes; ++v)
+    {
+        cout << "Node " << v << " -> component " << scc.component[v] << endl;
+    }
+    for (int c = 0; c < scc.count; ++c)
+    {
+        for (int d : scc.dag[c])
+        {
+            cout << "Component " << c << " -> component " << d << endl;
+        }
+    }
+
+    // A cycle witness for the directed graph, and the task levels once the back edge is gone
+    TopologicalOrder topo = parallelTopologicalSort(directedGraph);
+    cout << "\nCycle:";
+    for (int v : topo.cycle)
+    {
+        cout << " " << v;
+    }
+    cout << endl;
+    directedGraph[3].clear();
+    topo = parallelTopologicalSort(directedGraph);
+    cout << "Without 3 -> 1, topological order:";
+    for (int v : topo.order)
+    {
+        cout << " " << v << " (level " << topo.level[v] << ")";
+    }
+    cout << endl;
+
     // Check for cycle in the undirected graph
     if (detectCycleInGraph(nodes, undirectedGraph, false))
     {
@@ -1,19 +1,27 @@
 #include <iostream>
 #include <vector>
-#include <stack>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstring>
 using namespace std;
 
 class Graph
 {
 public:
-    int V;                // Number of vertices
-    vector<int> *adjList; // Adjacency list representation
+    int V;                       // Number of vertices
+    vector<vector<int>> adjList; // Adjacency list representation
 
     // Constructor to initialize the graph
     Graph(int V)
     {
         this->V = V;
-        adjList = new vector<int>[V];
+        adjList.resize(V);
     }
 
     // Function to add an undirected edge
@@ -38,53 +46,510 @@ public:
         }
     }
 
-    // Function to perform DFS and find all connected components
-    void DFS(int node, vector<bool> &visited)
+    // Component label of every vertex (the smallest vertex id in its component). Vertex ranges
+    // are split across threads that union their edges into a shared lock-free union-find.
+    // With sample set, Afforest-style: link the first few neighbours of every vertex, find the
+    // largest component from a random sample, and skip the remaining edges of its vertices
+    vector<int> componentLabels(int numThreads = 0, bool sample = false)
     {
-        stack<int> s;
-        s.push(node);
-        visited[node] = true;
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        vector<atomic<int>> parent(V);
+        for (int v = 0; v < V; v++)
+        {
+            parent[v].store(v, memory_order_relaxed);
+        }
 
-        while (!s.empty())
+        const int neighbourRounds = 2;
+        int skipLabel = -1;
+        size_t firstEdge = 0;
+        if (sample)
+        {
+            parallelRanges(V, numThreads, [&](int from, int to)
+                           {
+                               for (int u = from; u < to; u++)
+                                   for (size_t i = 0; i < adjList[u].size() && i < neighbourRounds; i++)
+                                       unite(parent, u, adjList[u][i]); });
+            parallelRanges(V, numThreads, [&](int from, int to)
+                           {
+                               for (int v = from; v < to; v++)
+                                   parent[v].store(find(parent, v), memory_order_relaxed); });
+            skipLabel = mostFrequentLabel(parent);
+            firstEdge = neighbourRounds;
+        }
+
+        // With sampling, edges leaving the giant component are still seen from their other end
+        parallelRanges(V, numThreads, [&](int from, int to)
+                       {
+                           for (int u = from; u < to; u++)
+                           {
+                               if (skipLabel != -1 && find(parent, u) == skipLabel)
+                                   continue;
+                               for (size_t i = firstEdge; i < adjList[u].size(); i++)
+                                   if (skipLabel != -1 || u < adjList[u][i])
+                                       unite(parent, u, adjList[u][i]);
+                           } });
+
+        vector<int> label(V);
+        parallelRanges(V, numThreads, [&](int from, int to)
+                       {
+                           for (int v = from; v < to; v++)
+                               label[v] = find(parent, v); });
+        return label;
+    }
+
+    // Function to find all connected components in the graph, each listed in vertex order
+    vector<vector<int>> findConnectedComponents()
+    {
+        vector<int> label = componentLabels(1);
+        vector<int> index(V, -1);
+        vector<vector<int>> components;
+        for (int v = 0; v < V; v++)
         {
-            int current = s.top();
-            s.pop();
-            cout << current << " ";
+            int root = label[v];
+            if (index[root] == -1)
+            {
+                index[root] = components.size();
+                components.emplace_back();
+            }
+            components[index[root]].push_back(v);
+        }
+        return components;
+    }
+
+private:
+    // Root of x with path splitting; a failed CAS only means another thread already moved x up
+    static int find(vector<atomic<int>> &parent, int x)
+    {
+        while (true)
+        {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x)
+            {
+                return x;
+            }
+            int grandparent = parent[p].load(memory_order_relaxed);
+            if (p != grandparent)
+            {
+                parent[x].compare_exchange_weak(p, grandparent, memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    // Link the larger root below the smaller one; retry if the root changed under us
+    static void unite(vector<atomic<int>> &parent, int u, int v)
+    {
+        while (true)
+        {
+            u = find(parent, u);
+            v = find(parent, v);
+            if (u == v)
+            {
+                return;
+            }
+            if (u < v)
+            {
+                swap(u, v);
+            }
+            int expected = u;
+            if (parent[u].compare_exchange_strong(expected, v, memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    // Most common root among 1024 random vertices (the giant component, if there is one)
+    int mostFrequentLabel(vector<atomic<int>> &parent)
+    {
+        unordered_map<int, int> count;
+        unsigned seed = 12345;
+        int best = -1;
+        for (int i = 0; i < 1024 && V > 0; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int root = find(parent, (seed >> 8) % V);
+            if (++count[root] > (best == -1 ? 0 : count[best]))
+            {
+                best = root;
+            }
+        }
+        return best;
+    }
+
+    // Run body(from, to) over [0, count) split into one contiguous range per thread
+    static void parallelRanges(int count, int numThreads, const function<void(int, int)> &body)
+    {
+        int workers = min(numThreads, (count + 4095) / 4096); // small graphs stay on one thread
+        if (workers <= 1)
+        {
+            body(0, count);
+            return;
+        }
+        vector<thread> threads;
+        for (int t = 0; t < workers; t++)
+        {
+            threads.emplace_back(body, (int)((long long)count * t / workers), (int)((long long)count * (t + 1) / workers));
+        }
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+    }
+};
+
+// Connected components of an edge stream in O(V) memory: edges are unioned as they arrive and
+// never stored, so no adjacency is built. Vertex ids beyond the current range grow the
+// union-find. componentCount() and componentSizes() can be asked at any point of the stream
+class StreamingComponents
+{
+public:
+    long long edgesSeen = 0;
+
+    // Vertex ids must lie in [0, maxVertices); the default keeps the two arrays under 2 GB
+    StreamingComponents(int V = 0, int maxVertices = 1 << 28) : maxVertices(maxVertices)
+    {
+        grow(min(V, maxVertices));
+    }
+
+    // Union a batch of edges given as consecutive (u, v) pairs. Stops at the first invalid edge
+    bool addEdges(const int *pairs, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!addEdge(pairs[2 * i], pairs[2 * i + 1]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns false (and ignores the edge) if an id is negative or not below maxVertices
+    bool addEdge(int u, int v)
+    {
+        if (u < 0 || v < 0 || u >= maxVertices || v >= maxVertices)
+        {
+            return false;
+        }
+        edgesSeen++;
+        if (max(u, v) >= (int)parent.size())
+        {
+            grow(max(u, v) + 1);
+        }
+        u = find(u);
+        v = find(v);
+        if (u == v)
+        {
+            return true;
+        }
+        if (size[u] < size[v])
+        {
+            swap(u, v);
+        }
+        parent[v] = u;
+        size[u] += size[v];
+        components--;
+        return true;
+    }
+
+    // Read "u v" lines (any whitespace) from file until EOF, in batches of batchBytes. Lines
+    // starting with '#' or '%' are comments. checkpoint is called after every checkpointEdges
+    // edges, if set. Returns false at the first malformed token, negative or too large id, or
+    // unpaired id; the edges before it stay applied
+    bool ingestText(FILE *file, long long checkpointEdges = 0, const function<void(StreamingComponents &)> &checkpoint = nullptr,
+                    size_t batchBytes = 1 << 20)
+    {
+        vector<char> buffer(max<size_t>(1, batchBytes));
+        long long nextCheckpoint = checkpointEdges > 0 && checkpoint ? edgesSeen + checkpointEdges : -1;
+        const long long limit = maxVertices;
+        long long value = 0; // stops growing once it reaches limit
+        int pending = -1;
+        bool inNumber = false, sign = false, negative = false, inComment = false, atEnd = false;
+        char previous = '\n'; // last character of the previous batch
+        while (!atEnd)
+        {
+            size_t got = fread(buffer.data(), 1, buffer.size(), file);
+            bytesRead += got;
+            if (got == 0)
+            {
+                buffer[0] = '\n'; // End the last token like any other
+                got = 1;
+                atEnd = true;
+            }
 
-            // Explore all neighbors of the current node
-            for (int neighbor : adjList[current])
+            size_t i = 0;
+            if (inComment)
             {
-                if (!visited[neighbor])
+                const char *end = (const char *)memchr(buffer.data(), '\n', got);
+                inComment = !end;
+                i = end ? end - buffer.data() : got;
+            }
+            for (; i < got; i++)
+            {
+                char c = buffer[i];
+                unsigned digit = (unsigned char)c - '0';
+                if (digit < 10)
+                {
+                    value = value < limit ? value * 10 + digit : value;
+                    inNumber = true;
+                }
+                else if (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+                {
+                    if (!inNumber && !sign)
+                    {
+                        continue;
+                    }
+                    if (!inNumber || negative || value >= limit)
+                    {
+                        return false;
+                    }
+                    if (pending == -1)
+                    {
+                        pending = value;
+                    }
+                    else
+                    {
+                        if (!addStreamed(pending, value, nextCheckpoint, checkpointEdges, checkpoint))
+                        {
+                            return false;
+                        }
+                        pending = -1;
+                    }
+                    value = 0;
+                    inNumber = sign = negative = false;
+                }
+                else if ((c == '-' || c == '+') && !sign && !inNumber)
+                {
+                    sign = true;
+                    negative = c == '-';
+                }
+                else if ((c == '#' || c == '%') && (i > 0 ? buffer[i - 1] : previous) == '\n')
+                {
+                    // Skip to the end of the line, which may be in a later batch
+                    const char *end = (const char *)memchr(&buffer[i], '\n', got - i);
+                    inComment = !end;
+                    i = end ? end - buffer.data() - 1 : got;
+                }
+                else
                 {
-                    visited[neighbor] = true;
-                    s.push(neighbor);
+                    return false;
                 }
             }
+            previous = buffer[got - 1];
         }
+        return pending == -1;
     }
 
-    // Function to find all connected components in the graph
-    void findConnectedComponents()
+    // Read binary (int32 u, int32 v) pairs from file until EOF, calling checkpoint after every
+    // checkpointEdges edges as ingestText does. Returns false at the first invalid id, on a read
+    // error, or if the stream ends inside a record (a truncated last edge)
+    bool ingestBinary(FILE *file, long long checkpointEdges = 0, const function<void(StreamingComponents &)> &checkpoint = nullptr,
+                      size_t batchBytes = 1 << 20)
     {
-        vector<bool> visited(V, false); // Array to keep track of visited nodes
+        const size_t RECORD = 2 * sizeof(int);
+        vector<int> buffer(max<size_t>(2, batchBytes / sizeof(int)) & ~size_t(1));
+        char *bytes = (char *)buffer.data();
+        long long nextCheckpoint = checkpointEdges > 0 && checkpoint ? edgesSeen + checkpointEdges : -1;
 
-        for (int i = 0; i < V; i++)
+        // Read bytes, not records, so a partial record at the end of one read (pipes return short
+        // reads) is carried over to the next one and a partial record at EOF is seen
+        size_t carry = 0, got;
+        while ((got = fread(bytes + carry, 1, buffer.size() * sizeof(int) - carry, file)) > 0)
+        {
+            bytesRead += got;
+            size_t records = (carry + got) / RECORD;
+            if (nextCheckpoint == -1)
+            {
+                if (!addEdges(buffer.data(), records))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < records; i++)
+                {
+                    if (!addStreamed(buffer[2 * i], buffer[2 * i + 1], nextCheckpoint, checkpointEdges, checkpoint))
+                    {
+                        return false;
+                    }
+                }
+            }
+            carry = (carry + got) % RECORD;
+            memmove(bytes, bytes + records * RECORD, carry);
+        }
+        return carry == 0 && !ferror(file);
+    }
+
+    int componentCount() const
+    {
+        return components;
+    }
+
+    long long bytes() const
+    {
+        return bytesRead;
+    }
+
+    // Sizes of all components, largest first
+    vector<int> componentSizes() const
+    {
+        vector<int> sizes;
+        for (int v = 0; v < (int)parent.size(); v++)
         {
-            if (!visited[i])
+            if (parent[v] == v)
             {
-                cout << "Connected Component: ";
-                DFS(i, visited);
-                cout << endl;
+                sizes.push_back(size[v]);
             }
         }
+        sort(sizes.rbegin(), sizes.rend());
+        return sizes;
+    }
+
+    // Component label of every vertex seen so far (its union-find root)
+    vector<int> labels()
+    {
+        vector<int> label(parent.size());
+        for (int v = 0; v < (int)parent.size(); v++)
+        {
+            label[v] = find(v);
+        }
+        return label;
+    }
+
+private:
+    vector<int> parent;
+    vector<int> size;
+    int components = 0;
+    int maxVertices;
+    long long bytesRead = 0;
+
+    // addEdge plus the checkpoint bookkeeping shared by both readers
+    bool addStreamed(int u, int v, long long &nextCheckpoint, long long checkpointEdges,
+                     const function<void(StreamingComponents &)> &checkpoint)
+    {
+        if (!addEdge(u, v))
+        {
+            return false;
+        }
+        if (edgesSeen == nextCheckpoint)
+        {
+            checkpoint(*this);
+            nextCheckpoint += checkpointEdges;
+        }
+        return true;
+    }
+
+    void grow(int V)
+    {
+        int old = parent.size();
+        if (V <= old)
+        {
+            return;
+        }
+        parent.resize(V);
+        size.resize(V, 1);
+        for (int v = old; v < V; v++)
+        {
+            parent[v] = v;
+        }
+        components += V - old;
+    }
+
+    // Root of x with path halving
+    int find(int x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
     }
 };
 
-int main()
+// Helper function to print the connected components
+void printComponents(const vector<vector<int>> &components)
+{
+    for (const auto &component : components)
+    {
+        string line = "Connected Component: ";
+        for (int v : component)
+        {
+            line += to_string(v) + " ";
+        }
+        cout << line << "\n";
+    }
+    cout << flush;
+}
+
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        // Random graph with a giant component: "6 bench <vertices>" (4 edges per vertex)
+        int n = argc > 2 ? atoi(argv[2]) : 2000000;
+        Graph random(n);
+        unsigned seed = 7;
+        for (long long i = 0; i < 2LL * n; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            random.addEdge(u, (seed >> 8) % n);
+        }
+
+        int maxThreads = max(1u, thread::hardware_concurrency());
+        for (bool sample : {false, true})
+        {
+            for (int threads = 1; threads <= maxThreads; threads *= 2)
+            {
+                auto begin = chrono::steady_clock::now();
+                vector<int> label = random.componentLabels(threads, sample);
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+                int components = 0;
+                for (int v = 0; v < n; v++)
+                {
+                    components += label[v] == v;
+                }
+                cout << (sample ? "Afforest" : "Union-find") << ", " << threads << " threads: " << ms << " ms, "
+                     << components << " components" << endl;
+            }
+        }
+        return 0;
+    }
+
+    if (argc > 1 && string(argv[1]) == "stream")
+    {
+        // "6 stream <vertices> <checkpoint edges> [binary]": components of "u v" lines on stdin
+        StreamingComponents stream(argc > 2 ? atoi(argv[2]) : 0);
+        long long every = argc > 3 ? atoll(argv[3]) : 0;
+        auto begin = chrono::steady_clock::now();
+        auto report = [&](StreamingComponents &s)
+        {
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+            vector<int> sizes = s.componentSizes();
+            cout << s.edgesSeen << " edges, " << s.componentCount() << " components, largest "
+                 << (sizes.empty() ? 0 : sizes[0]) << ", " << s.bytes() / 1048576.0 / max(seconds, 1e-9) << " MB/s" << endl;
+        };
+        bool binary = argc > 4 && string(argv[4]) == "binary";
+        bool ok = binary ? stream.ingestBinary(stdin, every, report) : stream.ingestText(stdin, every, report);
+        report(stream);
+        if (!ok)
+        {
+            cout << "Stopped after " << stream.edgesSeen << " edges: malformed input or vertex id out of range" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Create a graph with 5 vertices
     Graph g(5);
 
@@ -97,7 +562,7 @@ int main()
     g.printGraph();
 
     // Find and print all connected components
-    g.findConnectedComponents();
+    printComponents(g.findConnectedComponents());
     system("pause");
     return 0;
 }
@@ -1,14 +1,20 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <functional>
 
 using namespace std;
 
 class Graph
 {
 public:
-    int V;                   // Number of vertices
-    vector<vector<int>> adj; // Adjacency list
+    int V;                        // Number of vertices
+    vector<vector<int>> adj;      // Adjacency list
+    vector<pair<int, int>> edges; // Edge list, index = edge id
 
     Graph(int V)
     {
@@ -20,6 +26,7 @@ public:
     {
         adj[u].push_back(v);
         adj[v].push_back(u);
+        edges.push_back({u, v});
     }
 
     // Function to display the graph (adjacency list)
@@ -37,72 +44,568 @@ public:
         }
     }
 
-    // DFS function to find bridges
-    void DFS(int u, vector<bool> &visited, vector<int> &disc, vector<int> &low,
-             vector<int> &parent, vector<pair<int, int>> &bridges)
+    // Find all bridges (as edge ids) and articulation points with an iterative Tarjan DFS over a
+    // CSR adjacency, so long paths cannot overflow the call stack. The DFS skips only the edge
+    // id it arrived by, so a second parallel edge back to the parent counts as a back edge.
+    // If blockOf is given it receives the biconnected block of every edge (-1 for self-loops),
+    // numbered like parallelBiconnected: blocks in order of their lowest edge id
+    void findCutStructure(vector<int> &bridgeIds, vector<int> &articulationPoints, vector<int> *blockOf = nullptr)
     {
-        static int time = 0; // Static variable to keep track of discovery time
-        visited[u] = true;
-        disc[u] = low[u] = ++time; // Initialize discovery time and low value
+        vector<int> firstArc, arcTarget, arcEdge;
+        buildCSR(firstArc, arcTarget, arcEdge);
 
-        // Explore all the vertices adjacent to u
-        for (int v : adj[u])
+        struct Frame
         {
-            if (!visited[v])
+            int vertex;
+            int parentEdge; // edge id used to reach vertex (-1 for a root)
+            int nextArc;    // next arc of vertex to explore
+        };
+
+        vector<int> disc(V, -1); // Discovery times, -1 = not visited
+        vector<int> low(V, 0);   // Earliest discovery time reachable from the subtree
+        vector<char> isCut(V, 0);
+        vector<Frame> stack;
+        vector<int> edgeStack; // tree and back edges of the blocks still open (only with blockOf)
+        vector<int> rawBlock;
+        int rawBlocks = 0;
+        if (blockOf)
+        {
+            rawBlock.assign(edges.size(), -1);
+        }
+        int time = 0;
+
+        for (int root = 0; root < V; ++root)
+        {
+            if (disc[root] != -1)
             {
-                parent[v] = u;
-                DFS(v, visited, disc, low, parent, bridges);
+                continue;
+            }
+            disc[root] = low[root] = time++;
+            stack.push_back({root, -1, firstArc[root]});
+            int rootChildren = 0;
+
+            while (!stack.empty())
+            {
+                Frame &frame = stack.back();
+                int u = frame.vertex;
+
+                if (frame.nextArc < firstArc[u + 1])
+                {
+                    int arc = frame.nextArc++;
+                    int v = arcTarget[arc];
+                    if (arcEdge[arc] == frame.parentEdge)
+                    {
+                        continue;
+                    }
+                    if (disc[v] == -1)
+                    {
+                        if (blockOf)
+                        {
+                            edgeStack.push_back(arcEdge[arc]);
+                        }
+                        disc[v] = low[v] = time++;
+                        stack.push_back({v, arcEdge[arc], firstArc[v]}); // frame is invalid from here
+                    }
+                    else
+                    {
+                        if (blockOf && disc[v] < disc[u])
+                        {
+                            edgeStack.push_back(arcEdge[arc]); // each back edge once, from below
+                        }
+                        low[u] = min(low[u], disc[v]);
+                    }
+                    continue;
+                }
 
-                // After returning from DFS of v, update the low[u]
-                low[u] = min(low[u], low[v]);
+                // All arcs of u are done: report to the parent
+                int parentEdge = frame.parentEdge;
+                stack.pop_back();
+                if (stack.empty())
+                {
+                    break;
+                }
+                int p = stack.back().vertex;
+                low[p] = min(low[p], low[u]);
+
+                // No back edge from u's subtree climbs above p
+                if (low[u] > disc[p])
+                {
+                    bridgeIds.push_back(parentEdge);
+                }
+                if (p == root)
+                {
+                    rootChildren++;
+                }
+                else if (low[u] >= disc[p])
+                {
+                    isCut[p] = 1;
+                }
 
-                // Check if the subtree rooted at v has a connection back to one of the ancestors of u
-                if (low[v] > disc[u])
+                // p separates u's subtree: its open edges down to (p, u) form one block
+                if (blockOf && low[u] >= disc[p])
                 {
-                    // This means (u, v) is a bridge
-                    bridges.push_back({u, v});
+                    int id;
+                    do
+                    {
+                        id = edgeStack.back();
+                        edgeStack.pop_back();
+                        rawBlock[id] = rawBlocks;
+                    } while (id != parentEdge);
+                    rawBlocks++;
                 }
             }
-            // Update low value of u for parent function calls.
-            else if (v != parent[u])
+
+            if (rootChildren >= 2)
+            {
+                isCut[root] = 1;
+            }
+        }
+
+        for (int i = 0; i < V; ++i)
+        {
+            if (isCut[i])
+            {
+                articulationPoints.push_back(i);
+            }
+        }
+
+        if (blockOf)
+        {
+            vector<int> renumber(rawBlocks, -1);
+            int blocks = 0;
+            blockOf->assign(edges.size(), -1);
+            for (size_t id = 0; id < edges.size(); ++id)
             {
-                low[u] = min(low[u], disc[v]);
+                if (rawBlock[id] != -1)
+                {
+                    if (renumber[rawBlock[id]] == -1)
+                    {
+                        renumber[rawBlock[id]] = blocks++;
+                    }
+                    (*blockOf)[id] = renumber[rawBlock[id]];
+                }
             }
         }
     }
 
-    // Function to find and print all bridges
-    void findBridges()
+    // CSR adjacency: arcs of u are firstArc[u] .. firstArc[u + 1] - 1, each with its edge id
+    void buildCSR(vector<int> &firstArc, vector<int> &arcTarget, vector<int> &arcEdge)
     {
-        vector<bool> visited(V, false);
-        vector<int> disc(V, -1);        // Stores discovery times of visited vertices
-        vector<int> low(V, -1);         // Earliest visited vertex reachable from subtree
-        vector<int> parent(V, -1);      // Parent vertices in DFS tree
-        vector<pair<int, int>> bridges; // To store the bridges
+        firstArc.assign(V + 1, 0);
+        arcTarget.resize(2 * edges.size());
+        arcEdge.resize(2 * edges.size());
+        for (auto &edge : edges)
+        {
+            firstArc[edge.first + 1]++;
+            firstArc[edge.second + 1]++;
+        }
+        for (int i = 0; i < V; ++i)
+        {
+            firstArc[i + 1] += firstArc[i];
+        }
+        vector<int> slot(firstArc.begin(), firstArc.end() - 1);
+        for (int id = 0; id < (int)edges.size(); ++id)
+        {
+            int u = edges[id].first, v = edges[id].second;
+            arcTarget[slot[u]] = v;
+            arcEdge[slot[u]++] = id;
+            arcTarget[slot[v]] = u;
+            arcEdge[slot[v]++] = id;
+        }
+    }
+
+    // Parallel biconnected components (Tarjan-Vishkin). A level-synchronous BFS builds a spanning
+    // forest; preorder numbers and subtree sizes (the Euler-tour numbering) come from per-level
+    // prefix sums over children; low/high are subtree minima/maxima of non-tree neighbours.
+    // Tree edges are then merged into blocks with a lock-free union-find:
+    //   - a non-tree edge joins the tree edges above its two endpoints if these are unrelated
+    //   - a tree edge (v, w) joins the tree edge above v if w's subtree reaches outside v's subtree
+    // blockOf[id] is the block of every edge (-1 for self-loops); bridges are single-edge blocks
+    void parallelBiconnected(int numThreads, vector<int> &bridgeIds, vector<int> &articulationPoints,
+                             vector<int> &blockOf)
+    {
+        if (numThreads <= 0)
+        {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        int m = edges.size();
+        vector<int> firstArc, arcTarget, arcEdge;
+        buildCSR(firstArc, arcTarget, arcEdge);
+
+        // Spanning forest by level-synchronous BFS; parent is claimed with CAS
+        vector<atomic<int>> parent(V);
+        vector<int> parentEdge(V, -1);
+        for (int v = 0; v < V; ++v)
+        {
+            parent[v].store(-1, memory_order_relaxed);
+        }
+        vector<int> order;      // vertices level by level
+        vector<int> levelStart; // level k is order[levelStart[k] .. levelStart[k + 1] - 1]
+        vector<int> roots;
+        vector<vector<int>> nextLevel(numThreads);
+        for (int root = 0; root < V; ++root)
+        {
+            if (parent[root].load(memory_order_relaxed) != -1)
+            {
+                continue;
+            }
+            parent[root].store(root, memory_order_relaxed);
+            roots.push_back(root);
+            size_t from = order.size();
+            order.push_back(root);
+            while (from < order.size())
+            {
+                size_t to = order.size();
+                levelStart.push_back(from);
+                parallelFor(from, to, numThreads, [&](int t, size_t i)
+                            {
+                                int u = order[i];
+                                for (int arc = firstArc[u]; arc < firstArc[u + 1]; ++arc)
+                                {
+                                    int v = arcTarget[arc];
+                                    int expected = -1;
+                                    if (parent[v].load(memory_order_relaxed) == -1 &&
+                                        parent[v].compare_exchange_strong(expected, u))
+                                    {
+                                        parentEdge[v] = arcEdge[arc];
+                                        nextLevel[t].push_back(v);
+                                    }
+                                } });
+                for (vector<int> &level : nextLevel)
+                {
+                    order.insert(order.end(), level.begin(), level.end());
+                    level.clear();
+                }
+                from = to;
+            }
+        }
+        levelStart.push_back(order.size());
+        int levels = levelStart.size() - 1;
 
-        // Call DFS for all unvisited vertices
-        for (int i = 0; i < V; i++)
+        vector<char> isTree(m, 0);
+        for (int v = 0; v < V; ++v)
         {
-            if (!visited[i])
+            if (parentEdge[v] != -1)
             {
-                DFS(i, visited, disc, low, parent, bridges);
+                isTree[parentEdge[v]] = 1;
             }
         }
 
-        // Print all bridges
-        cout << "Bridges in the graph are:\n";
-        for (auto &bridge : bridges)
+        // Children of each vertex, contiguous in BFS order
+        vector<int> firstChild(V + 1, 0), children(V);
+        for (int v = 0; v < V; ++v)
+        {
+            if (parentEdge[v] != -1)
+            {
+                firstChild[parent[v] + 1]++;
+            }
+        }
+        for (int v = 0; v < V; ++v)
+        {
+            firstChild[v + 1] += firstChild[v];
+        }
+        {
+            vector<int> slot(firstChild.begin(), firstChild.end() - 1);
+            for (int v : order)
+            {
+                if (parentEdge[v] != -1)
+                {
+                    children[slot[parent[v]]++] = v;
+                }
+            }
+        }
+
+        // Local low/high: own preorder and preorders of non-tree neighbours (filled after pre)
+        vector<int> size(V, 1), pre(V, 0), low(V), high(V);
+        for (int level = levels - 1; level >= 0; --level)
+        {
+            parallelFor(levelStart[level], levelStart[level + 1], numThreads, [&](int, size_t i)
+                        {
+                            int u = order[i];
+                            for (int c = firstChild[u]; c < firstChild[u + 1]; ++c)
+                                size[u] += size[children[c]]; });
+        }
+        int nextPre = 0;
+        for (int root : roots)
+        {
+            pre[root] = nextPre;
+            nextPre += size[root];
+        }
+        for (int level = 0; level < levels; ++level)
+        {
+            parallelFor(levelStart[level], levelStart[level + 1], numThreads, [&](int, size_t i)
+                        {
+                            int u = order[i];
+                            int running = pre[u] + 1;
+                            for (int c = firstChild[u]; c < firstChild[u + 1]; ++c)
+                            {
+                                pre[children[c]] = running;
+                                running += size[children[c]];
+                            } });
+        }
+        parallelFor(0, V, numThreads, [&](int, size_t u)
+                    {
+                        low[u] = high[u] = pre[u];
+                        for (int arc = firstArc[u]; arc < firstArc[u + 1]; ++arc)
+                        {
+                            if (!isTree[arcEdge[arc]])
+                            {
+                                low[u] = min(low[u], pre[arcTarget[arc]]);
+                                high[u] = max(high[u], pre[arcTarget[arc]]);
+                            }
+                        } });
+        for (int level = levels - 1; level >= 0; --level)
+        {
+            parallelFor(levelStart[level], levelStart[level + 1], numThreads, [&](int, size_t i)
+                        {
+                            int u = order[i];
+                            for (int c = firstChild[u]; c < firstChild[u + 1]; ++c)
+                            {
+                                low[u] = min(low[u], low[children[c]]);
+                                high[u] = max(high[u], high[children[c]]);
+                            } });
+        }
+
+        // Union-find over tree edges; tree edge (parent[v], v) is represented by v
+        vector<atomic<int>> link(V);
+        for (int v = 0; v < V; ++v)
         {
-            cout << bridge.first << " - " << bridge.second << endl;
+            link[v].store(v, memory_order_relaxed);
+        }
+        auto inSubtree = [&](int x, int v)
+        {
+            return pre[v] <= pre[x] && pre[x] < pre[v] + size[v];
+        };
+        parallelFor(0, m, numThreads, [&](int, size_t id)
+                    {
+                        int v = edges[id].first, w = edges[id].second;
+                        if (!isTree[id] && v != w && !inSubtree(v, w) && !inSubtree(w, v))
+                            unite(link, v, w); });
+        parallelFor(0, V, numThreads, [&](int, size_t w)
+                    {
+                        if (parentEdge[w] == -1)
+                            return;
+                        int v = parent[w];
+                        if (parentEdge[v] != -1 && (low[w] < pre[v] || high[w] >= pre[v] + size[v]))
+                            unite(link, v, (int)w); });
+
+        // Every edge takes the block of the tree edge above its deeper endpoint
+        vector<int> rootOf(m, -1);
+        parallelFor(0, m, numThreads, [&](int, size_t id)
+                    {
+                        int v = edges[id].first, w = edges[id].second;
+                        if (v == w)
+                            return;
+                        int below = isTree[id] ? (parentEdge[v] == (int)id ? v : w) : (pre[v] > pre[w] ? v : w);
+                        rootOf[id] = find(link, below); });
+        vector<int> blockId(V, -1);
+        int blocks = 0;
+        blockOf.assign(m, -1);
+        for (int id = 0; id < m; ++id)
+        {
+            if (rootOf[id] != -1)
+            {
+                if (blockId[rootOf[id]] == -1)
+                {
+                    blockId[rootOf[id]] = blocks++;
+                }
+                blockOf[id] = blockId[rootOf[id]];
+            }
+        }
+
+        // A tree edge is a bridge when nothing in its subtree reaches outside
+        for (int v = 0; v < V; ++v)
+        {
+            if (parentEdge[v] != -1 && low[v] >= pre[v] && high[v] < pre[v] + size[v])
+            {
+                bridgeIds.push_back(parentEdge[v]);
+            }
+        }
+        sort(bridgeIds.begin(), bridgeIds.end());
+
+        // A vertex is a cut vertex when its edges belong to more than one block
+        vector<char> isCut(V, 0);
+        parallelFor(0, V, numThreads, [&](int, size_t u)
+                    {
+                        int first = -1;
+                        for (int arc = firstArc[u]; arc < firstArc[u + 1]; ++arc)
+                        {
+                            int block = blockOf[arcEdge[arc]];
+                            if (block == -1)
+                                continue;
+                            if (first == -1)
+                                first = block;
+                            else if (block != first)
+                            {
+                                isCut[u] = 1;
+                                break;
+                            }
+                        } });
+        for (int v = 0; v < V; ++v)
+        {
+            if (isCut[v])
+            {
+                articulationPoints.push_back(v);
+            }
+        }
+    }
+
+    // Function to find all bridges, as (u, v) pairs in the order they were added
+    vector<pair<int, int>> findBridges()
+    {
+        vector<int> bridgeIds, articulationPoints;
+        findCutStructure(bridgeIds, articulationPoints);
+        sort(bridgeIds.begin(), bridgeIds.end());
+
+        vector<pair<int, int>> bridges;
+        for (int id : bridgeIds)
+        {
+            bridges.push_back(edges[id]);
+        }
+        return bridges;
+    }
+
+    // Function to find all articulation points (cut vertices) in increasing order
+    vector<int> findArticulationPoints()
+    {
+        vector<int> bridgeIds, articulationPoints;
+        findCutStructure(bridgeIds, articulationPoints);
+        return articulationPoints;
+    }
+
+private:
+    // Run body(thread, i) for i in [begin, end), split into one contiguous chunk per thread
+    static void parallelFor(size_t begin, size_t end, int numThreads, const function<void(int, size_t)> &body)
+    {
+        size_t count = end - begin;
+        int workers = (int)min<size_t>(numThreads, (count + 1023) / 1024); // small ranges stay on one thread
+        if (workers <= 1)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                body(0, i);
+            }
+            return;
+        }
+        vector<thread> threads;
+        for (int t = 0; t < workers; ++t)
+        {
+            size_t from = begin + count * t / workers, to = begin + count * (t + 1) / workers;
+            threads.emplace_back([&, t, from, to]()
+                                 {
+                                     for (size_t i = from; i < to; ++i)
+                                         body(t, i); });
+        }
+        for (thread &th : threads)
+        {
+            th.join();
+        }
+    }
+
+    // Lock-free union-find: find with path splitting, union links the larger root under the smaller
+    static int find(vector<atomic<int>> &link, int x)
+    {
+        while (true)
+        {
+            int p = link[x].load(memory_order_relaxed);
+            int gp = link[p].load(memory_order_relaxed);
+            if (p == gp)
+            {
+                return p;
+            }
+            link[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    static void unite(vector<atomic<int>> &link, int a, int b)
+    {
+        while (true)
+        {
+            a = find(link, a);
+            b = find(link, b);
+            if (a == b)
+            {
+                return;
+            }
+            if (a < b)
+            {
+                swap(a, b);
+            }
+            int expected = a;
+            if (link[a].compare_exchange_strong(expected, b))
+            {
+                return;
+            }
         }
     }
 };
 
-int main()
+int main(int argc, char *argv[])
 {
     cout << "STT: 22520165\n";
     cout << "Full Name : Nguyen Chu Nguyen Chuong\n";
     cout << "Homework-Lap5\n";
+    if (argc > 1 && string(argv[1]) == "bench")
+    {
+        // A 2,000,000-vertex path: every edge is a bridge, every inner vertex is a cut vertex
+        int n = 2000000;
+        Graph chain(n);
+        for (int i = 0; i + 1 < n; ++i)
+        {
+            chain.addEdge(i, i + 1);
+        }
+        auto begin = chrono::steady_clock::now();
+        size_t bridgeCount = chain.findBridges().size();
+        size_t cutCount = chain.findArticulationPoints().size();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        cout << "Path of " << n << " vertices: " << bridgeCount << " bridges, " << cutCount
+             << " articulation points in " << ms << " ms" << endl;
+
+        // Sparse random graph: sequential DFS versus the parallel Tarjan-Vishkin version
+        int vertices = 1000000, edgeCount = 3000000;
+        Graph random(vertices);
+        unsigned seed = 5;
+        for (int i = 0; i < edgeCount; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % vertices;
+            seed = seed * 1103515245u + 12345u;
+            random.addEdge(u, (seed >> 8) % vertices);
+        }
+        vector<int> bridgeIds, articulationPoints, blockOf;
+        begin = chrono::steady_clock::now();
+        random.findCutStructure(bridgeIds, articulationPoints);
+        ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+        cout << "Random graph " << vertices << " vertices, " << edgeCount << " edges: sequential " << ms << " ms, "
+             << bridgeIds.size() << " bridges, " << articulationPoints.size() << " articulation points" << endl;
+
+        // Reference blocks from the sequential DFS (not timed: the edge stack is extra work)
+        vector<int> referenceBridges, referenceCuts, referenceBlocks;
+        random.findCutStructure(referenceBridges, referenceCuts, &referenceBlocks);
+        sort(referenceBridges.begin(), referenceBridges.end());
+
+        int maxThreads = max(4u, thread::hardware_concurrency());
+        for (int threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            vector<int> parallelBridges, parallelCuts;
+            begin = chrono::steady_clock::now();
+            random.parallelBiconnected(threads, parallelBridges, parallelCuts, blockOf);
+            ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+            cout << "Parallel, " << threads << " threads: " << ms << " ms, " << parallelBridges.size() << " bridges, "
+                 << parallelCuts.size() << " articulation points" << endl;
+            sort(parallelBridges.begin(), parallelBridges.end());
+            if (parallelBridges != referenceBridges || parallelCuts != referenceCuts || blockOf != referenceBlocks)
+            {
+                cout << "MISMATCH with the sequential DFS: " << (parallelBridges != referenceBridges ? "bridges " : "")
+                     << (parallelCuts != referenceCuts ? "articulation points " : "")
+                     << (blockOf != referenceBlocks ? "blocks" : "") << endl;
+                return 1;
+            }
+        }
+        return 0;
+    }
+
     // Create a graph
     Graph g(5);
 
@@ -117,7 +620,27 @@ int main()
     g.displayGraph();
 
     // Find and print all bridges
-    g.findBridges();
+    cout << "Bridges in the graph are:\n";
+    for (auto &bridge : g.findBridges())
+    {
+        cout << bridge.first << " - " << bridge.second << endl;
+    }
+
+    // Find and print all articulation points
+    cout << "Articulation points in the graph are:\n";
+    for (int vertex : g.findArticulationPoints())
+    {
+        cout << vertex << endl;
+    }
+
+    // Biconnected blocks of every edge
+    vector<int> bridgeIds, articulationPoints, blockOf;
+    g.parallelBiconnected(0, bridgeIds, articulationPoints, blockOf);
+    cout << "Biconnected blocks:\n";
+    for (size_t id = 0; id < g.edges.size(); ++id)
+    {
+        cout << g.edges[id].first << " - " << g.edges[id].second << ": block " << blockOf[id] << endl;
+    }
     system("pause");
     return 0;
 }